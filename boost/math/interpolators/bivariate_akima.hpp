@@ -0,0 +1,278 @@
+//  (C) Copyright Matt Borland 2022.
+//  Use, modification and distribution are subject to the
+//  Boost Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_MATH_INTERPOLATORS_BIVARIATE_AKIMA_HPP
+#define BOOST_MATH_INTERPOLATORS_BIVARIATE_AKIMA_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <utility>
+#include <boost/math/interpolators/detail/akima_image.hpp>
+#include <boost/math/interpolators/detail/akima_tables.hpp>
+#include <boost/math/interpolators/detail/bivariate_akima_detail.hpp>
+
+namespace boost { namespace math { namespace interpolators {
+
+// Akima's C1 interpolation of values z at scattered nodes (x, y): a quintic on each triangle of the
+// Delaunay triangulation of the nodes, built from the partial derivatives estimated at each node by a
+// least squares cubic through its nearest nodes. The 21 coefficients of each quintic are computed
+// once, at construction, in about 256 bytes per triangle for double, and the nearest nodes of each node
+// are kept so that new values on the same nodes are fitted without searching again. The surface is
+// defined on the convex hull of the nodes and evaluates to NaN outside of it.
+//
+// Evaluation is const, performs no allocation and modifies nothing shared, so one interpolator can be
+// used from many threads at once. Each query walks in a straight line to its triangle from that of the
+// previous query, which each thread remembers for the last few interpolators it queried, or in a hint
+// given explicitly: a hint lets a thread interleave coherent sequences of queries, such as two scan
+// lines, without them disturbing each other.
+//
+// The containers are taken as rvalues: std::vector<Real> becomes the storage of the interpolator as it
+// is, so that fitting does not hold two copies of the nodes, and other containers are copied. With
+// borrow_nodes the interpolator instead reads arrays of the caller in place.
+//
+// With float containers the nodes, the values and the quintics are stored in float, about 128 bytes per
+// triangle, and evaluation runs in float, with twice the lanes of double in each vector. The predicates
+// of the triangulation, the estimates of the derivatives and the fits of the quintics run in
+// promote_args<Real, double>, that is double, so that the triangles are those of double on the same
+// nodes and only the stored coefficients are rounded. For smooth data on 10^5 random or clustered nodes,
+// the values are then within about 2e-7 of the range of the values of those of double, the gradients at
+// the nodes within about 2e-5 relative. Between nodes the gradients lose more in thin triangles, such as
+// those along the convex hull, whose affine coordinates cancel in float. The nodes themselves are floats,
+// so coordinates far from the origin relative to the spacing of the nodes should be shifted first.
+//
+// Nodes and triangles are numbered with Index; the default 32 bits serve up to about 700 million nodes.
+// With the Statistics policy collect_statistics the interpolator counts its work, as reported by
+// statistics(); with no_statistics, the default, nothing is counted and nothing costs.
+template <class RandomAccessContainer, class Index = std::uint32_t, class Statistics = no_statistics>
+class bivariate_akima
+{
+public:
+    using Real = typename RandomAccessContainer::value_type;
+    using hint_type = typename detail::bivariate_akima_detail<RandomAccessContainer, Index, Statistics>::hint_type;
+
+    bivariate_akima (RandomAccessContainer&& x, RandomAccessContainer&& y, RandomAccessContainer&& z, std::size_t nearest = 12)
+        : impl_ {std::make_shared<detail::bivariate_akima_detail<RandomAccessContainer, Index, Statistics>>(std::move(x), std::move(y), std::move(z), 1, nearest)}
+    {}
+
+    // Builds the interpolator with the executor of detail/thread_executor.hpp, or any callable e(count, f)
+    // that calls f(0), ..., f(count - 1) concurrently: the nodes are triangulated by divide and conquer,
+    // and the derivatives and quintics are computed in tasks of consecutive nodes and triangles. The
+    // result is bitwise the same for any executor and number of threads. It has the same derivatives at
+    // the nodes as the serial constructor, but its triangles may list their vertices in another order, so
+    // its values may differ by rounding, and more where four or more nodes are cocircular.
+    template <class Executor>
+    bivariate_akima (Executor&& executor, RandomAccessContainer&& x, RandomAccessContainer&& y, RandomAccessContainer&& z, std::size_t nearest = 12)
+        : impl_ {std::make_shared<detail::bivariate_akima_detail<RandomAccessContainer, Index, Statistics>>(std::forward<Executor>(executor), std::move(x), std::move(y), std::move(z), 1, nearest)}
+    {}
+
+    // Borrows the n nodes (x[i], y[i]) and values z[i], which must outlive the interpolator and not
+    // change. It then holds no copy of them, and cannot insert or erase nodes; refit adopts its values.
+    bivariate_akima (borrow_nodes_t, const Real* x, const Real* y, const Real* z, std::size_t n, std::size_t nearest = 12)
+        : impl_ {std::make_shared<detail::bivariate_akima_detail<RandomAccessContainer, Index, Statistics>>(borrow_nodes, x, y, z, n, 1, nearest)}
+    {}
+
+    template <class Executor>
+    bivariate_akima (Executor&& executor, borrow_nodes_t, const Real* x, const Real* y, const Real* z, std::size_t n, std::size_t nearest = 12)
+        : impl_ {std::make_shared<detail::bivariate_akima_detail<RandomAccessContainer, Index, Statistics>>(std::forward<Executor>(executor), borrow_nodes, x, y, z, n, 1, nearest)}
+    {}
+
+    Real operator() (Real x, Real y) const
+    {
+        return impl_->operator()(x, y);
+    }
+
+    Real operator() (Real x, Real y, hint_type& hint) const
+    {
+        return impl_->operator()(x, y, hint);
+    }
+
+    // {z, z_x, z_y} at (x, y), from one location and one pass over the coefficients of its quintic; NaN
+    // outside of the convex hull. The value is that of operator().
+    std::array<Real, 3> value_and_gradient (Real x, Real y) const
+    {
+        return value_and_gradient(x, y, impl_->thread_hint());
+    }
+
+    std::array<Real, 3> value_and_gradient (Real x, Real y, hint_type& hint) const
+    {
+        std::array<Real, 3> result;
+        impl_->template channel_derivatives<1>(x, y, hint, result.begin());
+        return result;
+    }
+
+    // {z, z_x, z_y, z_xx, z_xy, z_yy} at (x, y), as value_and_gradient
+    std::array<Real, 6> value_gradient_hessian (Real x, Real y) const
+    {
+        return value_gradient_hessian(x, y, impl_->thread_hint());
+    }
+
+    std::array<Real, 6> value_gradient_hessian (Real x, Real y, hint_type& hint) const
+    {
+        std::array<Real, 6> result;
+        impl_->template channel_derivatives<2>(x, y, hint, result.begin());
+        return result;
+    }
+
+    // The interpolant that is linear on each triangle, from the same triangulation and location as
+    // operator(), with the values at three nodes in place of the 21 coefficients of the quintic: C0,
+    // exact for linear data and free of the overshoot of the quintics; NaN outside of the convex hull.
+    // Locating the query costs the same, so it is about as fast as operator().
+    Real linear (Real x, Real y) const
+    {
+        return linear(x, y, impl_->thread_hint());
+    }
+
+    Real linear (Real x, Real y, hint_type& hint) const
+    {
+        Real result;
+        impl_->linear_values(x, y, hint, &result);
+        return result;
+    }
+
+    // Sibson's natural neighbor interpolant of the values, from the triangles of the triangulation whose
+    // circumcircles hold (x, y): C1 away from the nodes, exact for linear data, and free of the overshoot
+    // of the quintics; NaN outside of the convex hull and linear on its boundary. The cavity is found and
+    // its areas computed for each query, which costs several times as much as operator(), in scratch space
+    // that each thread keeps and allocates only while it grows.
+    Real natural_neighbor (Real x, Real y) const
+    {
+        return natural_neighbor(x, y, impl_->thread_hint());
+    }
+
+    Real natural_neighbor (Real x, Real y, hint_type& hint) const
+    {
+        Real result;
+        impl_->natural_neighbor_values(x, y, hint, &result);
+        return result;
+    }
+
+    // Adds the node (x, y) with the value z and returns its index, which is the number of nodes before.
+    // The triangulation is updated about the node, the derivatives are estimated again only at the
+    // nodes that gain it among their nearest nodes, and the quintics are fitted again only on the
+    // triangles around those, so the cost depends on the neighborhood rather than on the number of
+    // nodes. The result is the interpolator that the nodes would give from scratch, up to rounding and
+    // to the choice of triangles where four or more nodes are cocircular. The containers must support
+    // push_back and pop_back. Neither this nor erase is thread safe, and both age the location index, as
+    // described at index_locations.
+    std::size_t insert (Real x, Real y, Real z)
+    {
+        return impl_->insert(x, y, &z);
+    }
+
+    // Removes the node with the given index, which then belongs to the last node, as in TRIPACK DELNOD.
+    // Only the nodes that had it among their nearest nodes, and the triangles around them and in its
+    // place, are fitted again.
+    void erase (std::size_t node)
+    {
+        impl_->erase(node);
+    }
+
+    // Replaces the values at the nodes, keeping the triangulation and the nearest nodes of each node, so
+    // that only the derivatives and the quintics are computed again. Not thread safe.
+    void refit (RandomAccessContainer&& z)
+    {
+        detail::sequential_executor executor;
+        impl_->refit(std::move(z), executor);
+    }
+
+    template <class Executor>
+    void refit (Executor&& executor, RandomAccessContainer&& z)
+    {
+        impl_->refit(std::move(z), executor);
+    }
+
+    // Builds a uniform grid over the nodes, with about cells_per_node cells per node, which maps each
+    // query to a nearby starting triangle; queries then walk a bounded number of triangles even when
+    // they jump about or the nodes are clustered. It is not thread safe and should be called before the
+    // interpolator is shared. insert and erase leave it stale, seeding walks from triangles that have
+    // moved or from the edge of the old bounding box, and rebuild it with the same cells_per_node once
+    // the changes since it was built reach a sixteenth of the nodes; calling it again after a batch of
+    // changes restores the short walks at once.
+    void index_locations (double cells_per_node = 1)
+    {
+        impl_->index_locations(cells_per_node);
+    }
+
+    // out[i] = (*this)(xs[i], ys[i]), with the queries reordered internally so that nearby ones share
+    // the work of locating their triangles and loading their quintics
+    template <class InputContainer, class OutputContainer>
+    void evaluate (const InputContainer& xs, const InputContainer& ys, OutputContainer& out) const
+    {
+        impl_->evaluate(xs, ys, out);
+    }
+
+    // out[3 * i], out[3 * i + 1], out[3 * i + 2] = value_and_gradient(xs[i], ys[i]), with the queries
+    // reordered as by evaluate
+    template <class InputContainer, class OutputContainer>
+    void evaluate_value_and_gradient (const InputContainer& xs, const InputContainer& ys, OutputContainer& out) const
+    {
+        impl_->template evaluate<1>(xs, ys, out);
+    }
+
+    // out[6 * i], ..., out[6 * i + 5] = value_gradient_hessian(xs[i], ys[i]), as evaluate_value_and_gradient
+    template <class InputContainer, class OutputContainer>
+    void evaluate_value_gradient_hessian (const InputContainer& xs, const InputContainer& ys, OutputContainer& out) const
+    {
+        impl_->template evaluate<2>(xs, ys, out);
+    }
+
+    // Writes the interpolant on the grid to out, as described at grid_spec, with NaN outside of the convex
+    // hull. The grid is filled triangle by triangle, with no point location, in tiles that are the tasks
+    // of the executor; each point takes the value of operator() in a triangle holding it.
+    void rasterize (const grid_spec<Real>& grid, Real* out) const
+    {
+        detail::sequential_executor executor;
+        impl_->rasterize(grid, 0, out, executor);
+    }
+
+    template <class Executor>
+    void rasterize (Executor&& executor, const grid_spec<Real>& grid, Real* out) const
+    {
+        impl_->rasterize(grid, 0, out, executor);
+    }
+
+    // The memory held by the interpolator, including the nodes and values unless they are borrowed
+    std::size_t bytes () const
+    {
+        return impl_->bytes();
+    }
+
+    // With the Statistics policy collect_statistics: the walks, arcs swapped and exact predicates of the
+    // triangulation, including those of the queries, and the seconds of each phase of fitting
+    bivariate_akima_statistics statistics () const
+    {
+        return impl_->statistics();
+    }
+
+    void reset_statistics ()
+    {
+        impl_->reset_statistics();
+    }
+
+    // Writes the fitted interpolator, with its location index if it has one, in the flat layout of
+    // detail/akima_image.hpp, which mapped_bivariate_akima evaluates in place. The stream must be binary.
+    void save (std::ostream& os) const
+    {
+        detail::write_akima_image(os, *impl_);
+    }
+
+    // The tables that evaluation reads, as plain pointers into the interpolator, for upload to a GPU and
+    // evaluation there by the kernels of detail/akima_tables.hpp, whose results are within a documented
+    // bound of those of the interpolator. They are valid while it lives and is not changed.
+    detail::akima_tables<Real, Index> tables () const
+    {
+        return detail::make_akima_tables(*impl_);
+    }
+
+private:
+    std::shared_ptr<detail::bivariate_akima_detail<RandomAccessContainer, Index, Statistics>> impl_;
+};
+
+}}} // Namespaces
+
+#endif // BOOST_MATH_INTERPOLATORS_BIVARIATE_AKIMA_HPP
@@ -0,0 +1,347 @@
+//  (C) Copyright Matt Borland 2022.
+//  Use, modification and distribution are subject to the
+//  Boost Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_MATH_INTERPOLATORS_DETAIL_AKIMA_IMAGE_HPP
+#define BOOST_MATH_INTERPOLATORS_DETAIL_AKIMA_IMAGE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <type_traits>
+#include <boost/math/interpolators/detail/akima_tables.hpp>
+#include <boost/math/interpolators/detail/bivariate_akima_detail.hpp>
+#include <boost/math/interpolators/detail/location_grid.hpp>
+#include <boost/math/interpolators/detail/triangulation.hpp>
+#include <boost/math/tools/promotion.hpp>
+
+namespace boost { namespace math { namespace interpolators { namespace detail {
+
+// The image of a fitted interpolator: a flat little-endian layout that is evaluated where it lies, so
+// that a file holding it can be mapped and shared by many processes instead of being read and fitted
+// by each. It is the header below followed by sections, each starting at a multiple of 64 bytes from
+// the start of the image and padded with zeros:
+//
+//   x, y        the abscissas and ordinates of the nodes, as Real
+//   vertices    three vertices per triangle, counterclockwise, the ghost vertex being the largest Index
+//   neighbors   the triangle across the edge opposite each vertex
+//   frame       the grid_frame<Real> of the location grid, all zeros if there is none
+//   seeds       a starting triangle for each of the cells of the location grid
+//   patches     the akima_patch<Real> of each channel on each triangle, channel by channel for each triangle
+//
+// The header records the widths of Real, Index and akima_patch, which must match those of the reader,
+// and the version, which changes with any change of the layout.
+struct akima_image_header
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t reserved;
+    std::uint16_t real_bytes;
+    std::uint16_t real_digits;
+    std::uint16_t index_bytes;
+    std::uint16_t patch_bytes;
+    std::uint64_t channels;
+    std::uint64_t nodes;
+    std::uint64_t triangles;
+    std::uint64_t cells;
+
+    // The size of the image and the offsets of its sections, in bytes
+    std::uint64_t bytes;
+    std::uint64_t offsets[7];
+};
+
+constexpr std::uint32_t akima_image_version = 1;
+constexpr std::size_t akima_image_alignment = 64;
+constexpr char akima_image_magic[8] = {'B', 'M', 'A', 'K', 'I', 'M', 'A', '\0'};
+
+inline std::uint64_t akima_image_align (std::uint64_t offset)
+{
+    return (offset + akima_image_alignment - 1) / akima_image_alignment * akima_image_alignment;
+}
+
+// The image is the memory of the interpolator, so it is only written and read on little-endian hosts
+inline void check_akima_image_byte_order ()
+{
+    const std::uint32_t one = 1;
+    unsigned char first;
+    std::memcpy(&first, &one, 1);
+    if (first != 1)
+    {
+        throw std::domain_error("Images of interpolators are little-endian, and this host is not.");
+    }
+}
+
+template <typename Real, typename Index>
+akima_image_header make_akima_image_header (std::uint64_t channels, std::uint64_t nodes, std::uint64_t triangles, std::uint64_t cells)
+{
+    akima_image_header header {};
+    std::copy(akima_image_magic, akima_image_magic + 8, header.magic);
+    header.version = akima_image_version;
+    header.real_bytes = sizeof(Real);
+    header.real_digits = std::numeric_limits<Real>::digits;
+    header.index_bytes = sizeof(Index);
+    header.patch_bytes = sizeof(akima_patch<Real>);
+    header.channels = channels;
+    header.nodes = nodes;
+    header.triangles = triangles;
+    header.cells = cells;
+
+    const std::uint64_t lengths[7] = {nodes * sizeof(Real), nodes * sizeof(Real), 3 * triangles * sizeof(Index),
+                                      3 * triangles * sizeof(Index), sizeof(grid_frame<Real>), cells * sizeof(Index),
+                                      channels * triangles * sizeof(akima_patch<Real>)};
+    std::uint64_t offset = akima_image_align(sizeof(akima_image_header));
+    for (int i = 0; i < 7; ++i)
+    {
+        header.offsets[i] = offset;
+        offset = akima_image_align(offset + lengths[i]);
+    }
+    header.bytes = offset;
+
+    return header;
+}
+
+// Writes count elements of type T, element(i) being the ith, through a buffer, then pads to the next section
+template <typename T, typename F>
+void write_akima_image_section (std::ostream& os, std::uint64_t& position, std::uint64_t count, F element)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Sections hold the bytes of their elements.");
+
+    constexpr std::size_t buffer_size = 4096 / sizeof(T) > 0 ? 4096 / sizeof(T) : 1;
+    T buffer[buffer_size];
+    for (std::uint64_t i = 0; i < count; i += buffer_size)
+    {
+        const auto m = static_cast<std::size_t>((std::min)(static_cast<std::uint64_t>(buffer_size), count - i));
+        for (std::size_t j = 0; j < m; ++j)
+        {
+            buffer[j] = element(i + j);
+        }
+        os.write(reinterpret_cast<const char*>(buffer), static_cast<std::streamsize>(m * sizeof(T)));
+    }
+    position += count * sizeof(T);
+
+    const char zeros[akima_image_alignment] = {};
+    const std::uint64_t end = akima_image_align(position);
+    os.write(zeros, static_cast<std::streamsize>(end - position));
+    position = end;
+}
+
+template <class RandomAccessContainer, class Index, class Statistics>
+void write_akima_image (std::ostream& os, const bivariate_akima_detail<RandomAccessContainer, Index, Statistics>& akima)
+{
+    using Real = typename RandomAccessContainer::value_type;
+    using index_type = Index;
+
+    check_akima_image_byte_order();
+    const auto& tri = akima.get_triangulation();
+    const auto& grid = akima.get_location_index();
+    const std::uint64_t cells = grid.empty() ? 0 : static_cast<std::uint64_t>(grid.columns()) * grid.rows();
+    const std::uint64_t patches = static_cast<std::uint64_t>(akima.channels()) * tri.triangle_count();
+    const akima_image_header header = make_akima_image_header<Real, Index>(akima.channels(), tri.size(), tri.triangle_count(), cells);
+
+    std::uint64_t position = 0;
+    write_akima_image_section<akima_image_header>(os, position, 1, [&](std::uint64_t) { return header; });
+    write_akima_image_section<Real>(os, position, header.nodes, [&](std::uint64_t v) { return tri.x(static_cast<index_type>(v)); });
+    write_akima_image_section<Real>(os, position, header.nodes, [&](std::uint64_t v) { return tri.y(static_cast<index_type>(v)); });
+    write_akima_image_section<index_type>(os, position, 3 * header.triangles, [&](std::uint64_t i)
+    {
+        return tri.vertex(static_cast<index_type>(i / 3), static_cast<int>(i % 3));
+    });
+    write_akima_image_section<index_type>(os, position, 3 * header.triangles, [&](std::uint64_t i)
+    {
+        return tri.neighbor(static_cast<index_type>(i / 3), static_cast<int>(i % 3));
+    });
+    write_akima_image_section<grid_frame<Real>>(os, position, 1, [&](std::uint64_t) { return grid.frame(); });
+    write_akima_image_section<index_type>(os, position, cells, [&](std::uint64_t c) { return grid.seeds()[c]; });
+    write_akima_image_section<akima_patch<Real>>(os, position, patches, [&](std::uint64_t i) { return akima.patches()[i]; });
+
+    if (!os)
+    {
+        throw std::domain_error("The image of the interpolator could not be written to the stream.");
+    }
+}
+
+// An interpolator evaluated from its image in place. Opening checks the header and the extent of the
+// sections, but not their contents, which must be an image written by write_akima_image.
+template <typename Real, typename Index = std::uint32_t>
+class akima_image
+{
+public:
+    using index_type = Index;
+    using predicate_type = typename boost::math::tools::promote_args<Real, double>::type;
+
+    static constexpr index_type npos = static_cast<index_type>(-1);
+
+    struct hint_type
+    {
+        index_type triangle = npos;
+        std::size_t cell = static_cast<std::size_t>(-1);
+    };
+
+    akima_image (const void* data, std::size_t bytes)
+    {
+        check_akima_image_byte_order();
+        if (bytes < sizeof(akima_image_header))
+        {
+            std::ostringstream oss;
+            oss << "An image holds at least the " << sizeof(akima_image_header) << " bytes of its header, but there are " << bytes << ".";
+            throw std::domain_error(oss.str());
+        }
+        if (reinterpret_cast<std::uintptr_t>(data) % akima_image_alignment != 0)
+        {
+            std::ostringstream oss;
+            oss << "An image must start at a multiple of " << akima_image_alignment << " bytes, as mappings do.";
+            throw std::domain_error(oss.str());
+        }
+
+        const auto base = static_cast<const unsigned char*>(data);
+        akima_image_header header;
+        std::memcpy(&header, base, sizeof(header));
+        if (!std::equal(akima_image_magic, akima_image_magic + 8, header.magic))
+        {
+            throw std::domain_error("The data is not the image of an interpolator.");
+        }
+        if (header.version != akima_image_version)
+        {
+            std::ostringstream oss;
+            oss << "The image has version " << header.version << ", but version " << akima_image_version << " is expected.";
+            throw std::domain_error(oss.str());
+        }
+        if (header.real_bytes != sizeof(Real) || header.real_digits != std::numeric_limits<Real>::digits ||
+            header.index_bytes != sizeof(Index) || header.patch_bytes != sizeof(akima_patch<Real>))
+        {
+            std::ostringstream oss;
+            oss << "The image has " << header.real_bytes << "-byte reals of " << header.real_digits << " digits, "
+                << header.index_bytes << "-byte indices and " << header.patch_bytes << "-byte quintics, but "
+                << sizeof(Real) << ", " << std::numeric_limits<Real>::digits << ", " << sizeof(Index) << " and "
+                << sizeof(akima_patch<Real>) << " are expected.";
+            throw std::domain_error(oss.str());
+        }
+        if (header.nodes < 3 || header.triangles == 0 || header.channels == 0 ||
+            header.triangles > (std::numeric_limits<index_type>::max)() / 3)
+        {
+            throw std::domain_error("The header of the image is corrupt.");
+        }
+        const akima_image_header expected = make_akima_image_header<Real, Index>(header.channels, header.nodes, header.triangles, header.cells);
+        if (!std::equal(expected.offsets, expected.offsets + 7, header.offsets) || expected.bytes != header.bytes)
+        {
+            throw std::domain_error("The sections of the image do not follow its header.");
+        }
+        if (header.bytes > bytes)
+        {
+            std::ostringstream oss;
+            oss << "The image has " << header.bytes << " bytes, but only " << bytes << " are given.";
+            throw std::domain_error(oss.str());
+        }
+
+        channels_ = static_cast<std::size_t>(header.channels);
+        nodes_ = static_cast<index_type>(header.nodes);
+        triangles_ = static_cast<index_type>(header.triangles);
+        cells_ = static_cast<std::size_t>(header.cells);
+        x_ = reinterpret_cast<const Real*>(base + header.offsets[0]);
+        y_ = reinterpret_cast<const Real*>(base + header.offsets[1]);
+        vertices_ = reinterpret_cast<const index_type*>(base + header.offsets[2]);
+        neighbors_ = reinterpret_cast<const index_type*>(base + header.offsets[3]);
+        std::memcpy(&frame_, base + header.offsets[4], sizeof(frame_));
+        seeds_ = reinterpret_cast<const index_type*>(base + header.offsets[5]);
+        patches_ = reinterpret_cast<const akima_patch<Real>*>(base + header.offsets[6]);
+    }
+
+    // Each thread resumes from the triangle of its own previous query of this image
+    hint_type& thread_hint () const
+    {
+        return detail::thread_hint<hint_type>(generation_);
+    }
+
+    // As bivariate_akima_detail::locate, so that an interpolator with a location index and its image
+    // find the same triangles
+    index_type locate (Real x, Real y, hint_type& hint) const
+    {
+        index_type start = hint.triangle;
+        if (cells_ > 0)
+        {
+            const std::size_t c = frame_.cell(x, y);
+            if (c != hint.cell || start == npos)
+            {
+                start = seeds_[c];
+                hint.cell = c;
+            }
+        }
+        if (!(start < triangles_))
+        {
+            start = 0;
+        }
+
+        const index_type t = straight_walk<predicate_type>(x_, y_, vertices_, neighbors_, triangles_, x, y, start);
+        hint.triangle = t != npos ? t : exhaustive_search<predicate_type>(x_, y_, vertices_, triangles_, x, y);
+        return hint.triangle;
+    }
+
+    bool is_ghost (index_type t) const
+    {
+        return vertices_[3 * t + 2] == npos;
+    }
+
+    const akima_patch<Real>& patch (index_type t, std::size_t c) const
+    {
+        return patches_[channels_ * t + c];
+    }
+
+    std::size_t channels () const
+    {
+        return channels_;
+    }
+
+    index_type size () const
+    {
+        return nodes_;
+    }
+
+    index_type triangle_count () const
+    {
+        return triangles_;
+    }
+
+    akima_tables<Real, Index> tables () const
+    {
+        akima_tables<Real, Index> tables;
+        tables.x = x_;
+        tables.y = y_;
+        tables.vertices = vertices_;
+        tables.neighbors = neighbors_;
+        tables.seeds = cells_ > 0 ? seeds_ : nullptr;
+        tables.patches = patches_;
+        tables.frame = frame_;
+        tables.nodes = nodes_;
+        tables.triangles = triangles_;
+        tables.cells = cells_;
+        tables.channels = channels_;
+        return tables;
+    }
+
+private:
+    std::uint64_t generation_ = next_generation();
+    std::size_t channels_;
+    index_type nodes_;
+    index_type triangles_;
+    std::size_t cells_;
+    grid_frame<Real> frame_;
+    const Real* x_;
+    const Real* y_;
+    const index_type* vertices_;
+    const index_type* neighbors_;
+    const index_type* seeds_;
+    const akima_patch<Real>* patches_;
+};
+
+template <typename Real, typename Index>
+constexpr typename akima_image<Real, Index>::index_type akima_image<Real, Index>::npos;
+
+}}}} // Namespaces
+
+#endif // BOOST_MATH_INTERPOLATORS_DETAIL_AKIMA_IMAGE_HPP
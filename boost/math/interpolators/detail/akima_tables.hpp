@@ -0,0 +1,317 @@
+//  (C) Copyright Matt Borland 2022.
+//  Use, modification and distribution are subject to the
+//  Boost Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_MATH_INTERPOLATORS_DETAIL_AKIMA_TABLES_HPP
+#define BOOST_MATH_INTERPOLATORS_DETAIL_AKIMA_TABLES_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <boost/math/interpolators/detail/bivariate_akima_detail.hpp>
+#include <boost/math/interpolators/detail/gpu.hpp>
+#include <boost/math/interpolators/detail/location_grid.hpp>
+#include <boost/math/interpolators/detail/thread_executor.hpp>
+#include <boost/math/interpolators/detail/triangulation.hpp>
+#include <boost/math/tools/promotion.hpp>
+
+#if defined(SYCL_LANGUAGE_VERSION)
+#include <sycl/sycl.hpp>
+#endif
+
+namespace boost { namespace math { namespace interpolators { namespace detail {
+
+// The tables of a fitted interpolator that evaluation reads, as plain pointers and counts, so that they
+// can be copied to a device once and evaluated there by many threads: the coordinates of the nodes, the
+// vertices and neighbors of the triangles, the location grid, if any, and the quintics of the channels.
+// The tables of an interpolator point into it, and are valid while it lives and is not changed; upload
+// copies them to memory that the caller allocates.
+//
+// Each query is located by the straight walk of the triangulation from the seed of its grid cell, or
+// from the first triangle without a grid, so the interpolator should index its locations first. The
+// orientations are those of robust_orient2d where its floating point filter decides them; where it does
+// not, on the host, expansion arithmetic decides, while the kernels count the query as on the edge. So
+// the kernels find the triangle of the host wherever a query is farther from the edges than the error
+// bound of the filter, and otherwise a triangle that the query lies on the boundary of, to rounding,
+// whose quintic agrees with that of the host's triangle along their common edge. Queries outside of the
+// convex hull by less than the error bound may get values rather than NaN.
+//
+// In the same triangle, the kernels evaluate the quintic with the operations of akima_patch, so that
+// they agree with the host bit for bit unless the device compiler contracts multiplications and
+// additions into fused operations, as nvcc does by default. For the Franke function interpolated on 10^5
+// random nodes, contraction moves the values at 10^6 random queries by at most 3 ulps, and the queries
+// at the midpoints of edges, where the triangles may differ, are within 1 ulp without it. In general the
+// bound is a few ulps of the sum of the magnitudes of the terms of the quintic, which exceeds the value
+// near its zeros. Compile with -fmad=false, or its counterpart, for results identical to the host.
+template <typename Real, typename Index = std::uint32_t>
+struct akima_tables
+{
+    using index_type = Index;
+    using predicate_type = typename boost::math::tools::promote_args<Real, double>::type;
+
+    const Real* x = nullptr;
+    const Real* y = nullptr;
+    const index_type* vertices = nullptr;
+    const index_type* neighbors = nullptr;
+    const index_type* seeds = nullptr;
+    const akima_patch<Real>* patches = nullptr;
+    grid_frame<Real> frame;
+    index_type nodes = 0;
+    index_type triangles = 0;
+    std::uint64_t cells = 0;
+    std::uint64_t channels = 0;
+
+    // The tables copied by copy(source, bytes), which returns the address of a copy of the bytes at
+    // source: cudaMalloc and cudaMemcpy for CUDA, or sycl::malloc_device and queue::memcpy for SYCL. The
+    // copies belong to the caller.
+    template <typename Copy>
+    akima_tables upload (Copy copy) const
+    {
+        akima_tables device = *this;
+        device.x = static_cast<const Real*>(copy(static_cast<const void*>(x), sizeof(Real) * nodes));
+        device.y = static_cast<const Real*>(copy(static_cast<const void*>(y), sizeof(Real) * nodes));
+        device.vertices = static_cast<const index_type*>(copy(static_cast<const void*>(vertices), 3 * sizeof(index_type) * triangles));
+        device.neighbors = static_cast<const index_type*>(copy(static_cast<const void*>(neighbors), 3 * sizeof(index_type) * triangles));
+        device.seeds = cells > 0 ? static_cast<const index_type*>(copy(static_cast<const void*>(seeds), sizeof(index_type) * cells)) : nullptr;
+        device.patches = static_cast<const akima_patch<Real>*>(copy(static_cast<const void*>(patches), sizeof(akima_patch<Real>) * channels * triangles));
+        return device;
+    }
+
+    // The bytes that upload copies
+    std::size_t bytes () const
+    {
+        return 2 * sizeof(Real) * nodes + 6 * sizeof(index_type) * triangles + sizeof(index_type) * cells +
+               sizeof(akima_patch<Real>) * channels * triangles;
+    }
+};
+
+template <class RandomAccessContainer, class Index, class Statistics>
+akima_tables<typename RandomAccessContainer::value_type, Index> make_akima_tables (const bivariate_akima_detail<RandomAccessContainer, Index, Statistics>& akima)
+{
+    const auto& tri = akima.get_triangulation();
+    const auto& grid = akima.get_location_index();
+    akima_tables<typename RandomAccessContainer::value_type, Index> tables;
+    tables.x = tri.x_data();
+    tables.y = tri.y_data();
+    tables.vertices = tri.vertex_data();
+    tables.neighbors = tri.neighbor_data();
+    tables.patches = akima.patches();
+    tables.nodes = tri.size();
+    tables.triangles = tri.triangle_count();
+    tables.channels = akima.channels();
+    if (!grid.empty())
+    {
+        tables.seeds = grid.seeds();
+        tables.frame = grid.frame();
+        tables.cells = static_cast<std::uint64_t>(grid.columns()) * grid.rows();
+    }
+    return tables;
+}
+
+// The sign of orient2d where the filter of robust_orient2d decides it, and otherwise 0
+template <typename Predicate>
+BOOST_MATH_INTERPOLATORS_GPU_ENABLED int filtered_orient2d (Predicate ax, Predicate ay, Predicate bx, Predicate by, Predicate cx, Predicate cy)
+{
+    // orient2d_error_bound, which a kernel cannot call
+    constexpr Predicate bound = (3 + 8 * std::numeric_limits<Predicate>::epsilon()) * std::numeric_limits<Predicate>::epsilon() / 2;
+
+    const Predicate left = (bx - ax) * (cy - ay);
+    const Predicate right = (by - ay) * (cx - ax);
+    const Predicate det = left - right;
+    const Predicate magnitude = (left < 0 ? -left : left) + (right < 0 ? -right : right);
+    if (det > 0 && det >= bound * magnitude)
+    {
+        return 1;
+    }
+    if (det < 0 && -det >= bound * magnitude)
+    {
+        return -1;
+    }
+    return 0;
+}
+
+// straight_walk on the tables from the seed of the cell of (x, y), with filtered_orient2d. If rounding
+// defeats the walk, the triangle whose orientations are the least negative, in floating point.
+template <typename Real, typename Index>
+BOOST_MATH_INTERPOLATORS_GPU_ENABLED Index akima_tables_locate (const akima_tables<Real, Index>& tables, Real x, Real y)
+{
+    using predicate_type = typename akima_tables<Real, Index>::predicate_type;
+    constexpr Index npos = static_cast<Index>(-1);
+
+    const predicate_type qx = x;
+    const predicate_type qy = y;
+    auto px = [&](Index v) { return static_cast<predicate_type>(tables.x[v]); };
+    auto py = [&](Index v) { return static_cast<predicate_type>(tables.y[v]); };
+
+    Index t = tables.cells > 0 ? tables.seeds[tables.frame.cell(x, y)] : 0;
+    if (tables.vertices[3 * t + 2] == npos)
+    {
+        t = tables.neighbors[3 * t + 2];
+    }
+
+    const Index start_triangle = t;
+    bool centered = false;
+    predicate_type sx = 0;
+    predicate_type sy = 0;
+    Index previous = npos;
+    for (Index steps = 0; steps <= tables.triangles; ++steps)
+    {
+        const Index* v = tables.vertices + 3 * t;
+        int beyond[2] = {0, 0};
+        int count = 0;
+        for (int i = 0; i < 3 && count < 2; ++i)
+        {
+            const Index a = v[(i + 1) % 3];
+            const Index b = v[(i + 2) % 3];
+            if (tables.neighbors[3 * t + i] != previous && filtered_orient2d(px(a), py(a), px(b), py(b), qx, qy) < 0)
+            {
+                beyond[count++] = i;
+            }
+        }
+
+        if (count == 0)
+        {
+            return t;
+        }
+
+        int exit = beyond[0];
+        if (count == 2)
+        {
+            if (!centered)
+            {
+                centered = true;
+                const Index* w = tables.vertices + 3 * start_triangle;
+                sx = (px(w[0]) + px(w[1]) + px(w[2])) / 3;
+                sy = (py(w[0]) + py(w[1]) + py(w[2])) / 3;
+            }
+            const Index a = v[(exit + 1) % 3];
+            const Index b = v[(exit + 2) % 3];
+            const int oa = filtered_orient2d(sx, sy, qx, qy, px(a), py(a));
+            const int ob = filtered_orient2d(sx, sy, qx, qy, px(b), py(b));
+            if ((oa < 0 && ob < 0) || (oa > 0 && ob > 0))
+            {
+                exit = beyond[1];
+            }
+        }
+
+        previous = t;
+        t = tables.neighbors[3 * t + exit];
+        if (tables.vertices[3 * t + 2] == npos)
+        {
+            return t;
+        }
+    }
+
+    Index best = 0;
+    predicate_type best_orientation = -std::numeric_limits<predicate_type>::infinity();
+    for (Index s = 0; s < tables.triangles; ++s)
+    {
+        const Index* v = tables.vertices + 3 * s;
+        predicate_type orientation = std::numeric_limits<predicate_type>::infinity();
+        for (int i = 0; i < 3 && v[2] != npos; ++i)
+        {
+            const Index a = v[(i + 1) % 3];
+            const Index b = v[(i + 2) % 3];
+            const predicate_type o = (px(b) - px(a)) * (qy - py(a)) - (py(b) - py(a)) * (qx - px(a));
+            orientation = o < orientation ? o : orientation;
+        }
+        if (v[2] != npos && orientation > best_orientation)
+        {
+            best = s;
+            best_orientation = orientation;
+        }
+    }
+    return best;
+}
+
+// The value of channel c at (x, y), NaN outside of the convex hull, where the triangles are ghost ones
+// with NaN coefficients
+template <typename Real, typename Index>
+BOOST_MATH_INTERPOLATORS_GPU_ENABLED Real akima_tables_value (const akima_tables<Real, Index>& tables, Real x, Real y, std::size_t c = 0)
+{
+    return tables.patches[tables.channels * akima_tables_locate(tables, x, y) + c](x, y);
+}
+
+// The values of the channels at (x, y), out[c] for each channel c, from the quintics of one triangle
+template <typename Real, typename Index>
+BOOST_MATH_INTERPOLATORS_GPU_ENABLED void akima_tables_values (const akima_tables<Real, Index>& tables, Real x, Real y, Real* out)
+{
+    const akima_patch<Real>* patch = tables.patches + tables.channels * akima_tables_locate(tables, x, y);
+    for (std::uint64_t c = 0; c < tables.channels; ++c)
+    {
+        out[c] = patch[c](x, y);
+    }
+}
+
+// The host backend: out[channels * i + c] is the value of channel c at (xs[i], ys[i]), by the kernel of
+// the devices, in tasks of the executor. It checks what a device would compute.
+template <typename Real, typename Index, typename Executor>
+void evaluate_akima_tables (const akima_tables<Real, Index>& tables, const Real* xs, const Real* ys, Real* out, std::size_t n, Executor&& executor)
+{
+    constexpr std::size_t chunk = 4096;
+    executor((n + chunk - 1) / chunk, [&](std::size_t k)
+    {
+        const std::size_t last = (std::min)(n, (k + 1) * chunk);
+        for (std::size_t i = k * chunk; i < last; ++i)
+        {
+            akima_tables_values(tables, xs[i], ys[i], out + tables.channels * i);
+        }
+    });
+}
+
+template <typename Real, typename Index>
+void evaluate_akima_tables (const akima_tables<Real, Index>& tables, const Real* xs, const Real* ys, Real* out, std::size_t n)
+{
+    evaluate_akima_tables(tables, xs, ys, out, n, sequential_executor());
+}
+
+#if defined(__CUDACC__)
+
+template <typename Real, typename Index>
+__global__ void akima_tables_kernel (akima_tables<Real, Index> tables, const Real* xs, const Real* ys, Real* out, std::size_t n)
+{
+    const std::size_t i = static_cast<std::size_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+    if (i < n)
+    {
+        akima_tables_values(tables, xs[i], ys[i], out + tables.channels * i);
+    }
+}
+
+// evaluate_akima_tables on a CUDA device, for tables, queries and outputs in device memory, as a
+// kernel launched on the stream. Compile with --expt-relaxed-constexpr.
+template <typename Real, typename Index>
+cudaError_t cuda_evaluate_akima_tables (const akima_tables<Real, Index>& tables, const Real* xs, const Real* ys, Real* out, std::size_t n,
+                                        cudaStream_t stream = 0)
+{
+    constexpr unsigned threads = 256;
+    if (n > 0)
+    {
+        const auto blocks = static_cast<unsigned>((n + threads - 1) / threads);
+        akima_tables_kernel<<<blocks, threads, 0, stream>>>(tables, xs, ys, out, n);
+    }
+    return cudaGetLastError();
+}
+
+#endif
+
+#if defined(SYCL_LANGUAGE_VERSION)
+
+// evaluate_akima_tables on the device of a SYCL queue, for tables, queries and outputs in its device
+// or shared memory
+template <typename Real, typename Index>
+sycl::event sycl_evaluate_akima_tables (sycl::queue& queue, const akima_tables<Real, Index>& tables, const Real* xs, const Real* ys,
+                                        Real* out, std::size_t n)
+{
+    return queue.parallel_for(sycl::range<1>(n), [=](sycl::id<1> i)
+    {
+        akima_tables_values(tables, xs[i], ys[i], out + tables.channels * i);
+    });
+}
+
+#endif
+
+}}}} // Namespaces
+
+#endif // BOOST_MATH_INTERPOLATORS_DETAIL_AKIMA_TABLES_HPP
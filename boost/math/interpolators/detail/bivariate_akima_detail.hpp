@@ -0,0 +1,1813 @@
+//  (C) Copyright Matt Borland 2022.
+//  Use, modification and distribution are subject to the
+//  Boost Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+//  Akima, H. (1978). A Method of Bivariate Interpolation and Smooth Surface Fitting for Irregularly
+//  Distributed Data Points. ACM Transactions on Mathematical Software 4, 148-164.
+//
+//  Akima, H. (1996). Algorithm 761: scattered-data surface fitting that has the accuracy of a cubic
+//  polynomial. ACM Transactions on Mathematical Software 22, 362-371.
+
+#ifndef BOOST_MATH_INTERPOLATORS_DETAIL_BIVARIATE_AKIMA_DETAIL_HPP
+#define BOOST_MATH_INTERPOLATORS_DETAIL_BIVARIATE_AKIMA_DETAIL_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include <boost/align/aligned_allocator.hpp>
+#include <boost/math/tools/promotion.hpp>
+#include <boost/math/interpolators/detail/gpu.hpp>
+#include <boost/math/interpolators/detail/location_grid.hpp>
+#include <boost/math/interpolators/detail/thread_executor.hpp>
+#include <boost/math/interpolators/detail/triangulation.hpp>
+
+namespace boost { namespace math { namespace interpolators {
+
+// The points (x0 + i dx, y0 + j dy) of a regular grid, 0 <= i < columns and 0 <= j < rows, whose values
+// rasterize writes to out[j * row_stride + i * column_stride]. The spacings may be negative, as for
+// rows running from north to south.
+template <typename Real>
+struct grid_spec
+{
+    Real x0;
+    Real y0;
+    Real dx;
+    Real dy;
+    std::size_t columns;
+    std::size_t rows;
+    std::ptrdiff_t row_stride;
+    std::ptrdiff_t column_stride = 1;
+};
+
+namespace detail {
+
+// Offset of the coefficient of u^j v^k in the 21 coefficients of a quintic
+constexpr int akima_index (int j, int k)
+{
+    return j * (13 - j) / 2 + k;
+}
+
+// The quintic of Akima's method on one triangle (IDPTIP). It is written in the affine coordinates
+// (u, v) in which the vertices are (0, 0), (1, 0) and (0, 1), matches the values and the first and
+// second derivatives given at the vertices, and has a cubic normal derivative along each edge, so
+// that the patches of adjacent triangles join with continuous first derivatives. Patches are aligned
+// to cache lines, so that evaluating one reads the fewest lines. Fitting and evaluation are constexpr,
+// so that the quintics of a fixed stencil can be computed at compile time.
+template <typename Real>
+struct alignas(64) akima_patch
+{
+    // (x, y) -> (u, v)
+    Real x0;
+    Real y0;
+    Real ap;
+    Real bp;
+    Real cp;
+    Real dp;
+
+    // Coefficient of u^j v^k at akima_index(j, k)
+    Real p[21];
+
+    // x, y, z and (z_x, z_y, z_xx, z_xy, z_yy) at the counterclockwise vertices
+    constexpr void fit (const Real (&x)[3], const Real (&y)[3], const Real (&z)[3], const Real* const (&d)[3])
+    {
+        const Real a = x[1] - x[0];
+        const Real b = x[2] - x[0];
+        const Real c = y[1] - y[0];
+        const Real e = y[2] - y[0];
+        const Real ad = a * e;
+        const Real bc = b * c;
+        const Real dlt = ad - bc;
+
+        x0 = x[0];
+        y0 = y[0];
+        ap = e / dlt;
+        bp = -b / dlt;
+        cp = -c / dlt;
+        dp = a / dlt;
+
+        // Derivatives with respect to u and v at the vertices
+        Real zu[3] = {};
+        Real zv[3] = {};
+        Real zuu[3] = {};
+        Real zuv[3] = {};
+        Real zvv[3] = {};
+        for (int i = 0; i < 3; ++i)
+        {
+            const Real* di = d[i];
+            zu[i] = a * di[0] + c * di[1];
+            zv[i] = b * di[0] + e * di[1];
+            zuu[i] = a * a * di[2] + 2 * a * c * di[3] + c * c * di[4];
+            zuv[i] = a * b * di[2] + (ad + bc) * di[3] + c * e * di[4];
+            zvv[i] = b * b * di[2] + 2 * b * e * di[3] + e * e * di[4];
+        }
+
+        Real& p00 = p[akima_index(0, 0)];
+        Real& p10 = p[akima_index(1, 0)];
+        Real& p01 = p[akima_index(0, 1)];
+        Real& p20 = p[akima_index(2, 0)];
+        Real& p11 = p[akima_index(1, 1)];
+        Real& p02 = p[akima_index(0, 2)];
+        p00 = z[0];
+        p10 = zu[0];
+        p01 = zv[0];
+        p20 = zuu[0] / 2;
+        p11 = zuv[0];
+        p02 = zvv[0] / 2;
+
+        // Along the edges v = 0 and u = 0
+        Real h1 = z[1] - p00 - p10 - p20;
+        Real h2 = zu[1] - p10 - zuu[0];
+        Real h3 = zuu[1] - zuu[0];
+        Real& p30 = p[akima_index(3, 0)];
+        Real& p40 = p[akima_index(4, 0)];
+        Real& p50 = p[akima_index(5, 0)];
+        p30 = 10 * h1 - 4 * h2 + h3 / 2;
+        p40 = -15 * h1 + 7 * h2 - h3;
+        p50 = 6 * h1 - 3 * h2 + h3 / 2;
+
+        h1 = z[2] - p00 - p01 - p02;
+        h2 = zv[2] - p01 - zvv[0];
+        h3 = zvv[2] - zvv[0];
+        Real& p03 = p[akima_index(0, 3)];
+        Real& p04 = p[akima_index(0, 4)];
+        Real& p05 = p[akima_index(0, 5)];
+        p03 = 10 * h1 - 4 * h2 + h3 / 2;
+        p04 = -15 * h1 + 7 * h2 - h3;
+        p05 = 6 * h1 - 3 * h2 + h3 / 2;
+
+        // Cubic normal derivatives along the edges v = 0 and u = 0
+        const Real lu2 = a * a + c * c;
+        const Real lv2 = b * b + e * e;
+        const Real uv = a * b + c * e;
+        Real& p41 = p[akima_index(4, 1)];
+        Real& p14 = p[akima_index(1, 4)];
+        p41 = 5 * uv / lu2 * p50;
+        p14 = 5 * uv / lv2 * p05;
+
+        h1 = zv[1] - p01 - p11 - p41;
+        h2 = zuv[1] - p11 - 4 * p41;
+        Real& p21 = p[akima_index(2, 1)];
+        Real& p31 = p[akima_index(3, 1)];
+        p21 = 3 * h1 - h2;
+        p31 = -2 * h1 + h2;
+
+        h1 = zu[2] - p10 - p11 - p14;
+        h2 = zuv[2] - p11 - 4 * p14;
+        Real& p12 = p[akima_index(1, 2)];
+        Real& p13 = p[akima_index(1, 3)];
+        p12 = 3 * h1 - h2;
+        p13 = -2 * h1 + h2;
+
+        // Cubic normal derivative along the edge u + v = 1. The normal is alpha (a, c) + beta (b, e) up to
+        // a factor, and only the quintic terms contribute to the s^4 term of the normal derivative at
+        // (1 - s, s), with the coefficient (-1)^j (beta k - alpha j) for u^j v^k.
+        const Real sx = b - a;
+        const Real sy = e - c;
+        const Real alpha = -(b * sx + e * sy);
+        const Real beta = a * sx + c * sy;
+        h1 = 5 * alpha * p50 + (beta - 4 * alpha) * p41 + (alpha - 4 * beta) * p14 + 5 * beta * p05;
+        h2 = zvv[1] / 2 - p02 - p12;
+        h3 = zuu[2] / 2 - p20 - p21;
+        Real& p22 = p[akima_index(2, 2)];
+        p22 = (h1 + (3 * alpha - 2 * beta) * h2 + (3 * beta - 2 * alpha) * h3) / (alpha + beta);
+        p[akima_index(3, 2)] = h2 - p22;
+        p[akima_index(2, 3)] = h3 - p22;
+    }
+
+    // The patch fitted in another precision, with its coefficients rounded to Real
+    template <typename Other>
+    constexpr void assign (const akima_patch<Other>& other)
+    {
+        x0 = static_cast<Real>(other.x0);
+        y0 = static_cast<Real>(other.y0);
+        ap = static_cast<Real>(other.ap);
+        bp = static_cast<Real>(other.bp);
+        cp = static_cast<Real>(other.cp);
+        dp = static_cast<Real>(other.dp);
+        for (int i = 0; i < 21; ++i)
+        {
+            p[i] = static_cast<Real>(other.p[i]);
+        }
+    }
+
+    BOOST_MATH_INTERPOLATORS_GPU_ENABLED constexpr Real operator() (Real x, Real y) const
+    {
+        const Real dx = x - x0;
+        const Real dy = y - y0;
+        const Real u = ap * dx + bp * dy;
+        const Real v = cp * dx + dp * dy;
+
+        const Real h0 = p[0] + v * (p[1] + v * (p[2] + v * (p[3] + v * (p[4] + v * p[5]))));
+        const Real h1 = p[6] + v * (p[7] + v * (p[8] + v * (p[9] + v * p[10])));
+        const Real h2 = p[11] + v * (p[12] + v * (p[13] + v * p[14]));
+        const Real h3 = p[15] + v * (p[16] + v * p[17]);
+        const Real h4 = p[18] + v * p[19];
+        return h0 + u * (h1 + u * (h2 + u * (h3 + u * (h4 + u * p[20]))));
+    }
+
+    // The value and the derivatives up to Order, 1 or 2, at (x, y), in one pass of Horner's rule that
+    // carries the derivatives along: d[0] = z, d[1] = z_x, d[2] = z_y and, for Order 2, d[3] = z_xx,
+    // d[4] = z_xy, d[5] = z_yy. The value is computed as by operator().
+    template <int Order>
+    BOOST_MATH_INTERPOLATORS_GPU_ENABLED constexpr void derivatives (Real x, Real y, Real* d) const
+    {
+        static_assert(Order == 1 || Order == 2, "Only the first and second derivatives are provided.");
+        const Real dx = x - x0;
+        const Real dy = y - y0;
+        const Real u = ap * dx + bp * dy;
+        const Real v = cp * dx + dp * dy;
+
+        // The coefficients of u^j, polynomials in v, with their first and second derivatives in v
+        Real h[6] = {};
+        Real hv[6] = {};
+        Real hvv[6] = {};
+        for (int j = 0; j < 6; ++j)
+        {
+            const int first = akima_index(j, 0);
+            Real a = p[first + 5 - j];
+            Real b = 0;
+            Real c = 0;
+            for (int k = 4 - j; k >= 0; --k)
+            {
+                c = c * v + b;
+                b = b * v + a;
+                a = a * v + p[first + k];
+            }
+            h[j] = a;
+            hv[j] = b;
+            hvv[j] = 2 * c;
+        }
+
+        // The same in u, for z, z_u and z_uu from h, z_v and z_uv from hv, and z_vv from hvv
+        Real z = h[5];
+        Real zu = 0;
+        Real zuu = 0;
+        Real zv = hv[5];
+        Real zuv = 0;
+        Real zvv = hvv[5];
+        for (int j = 4; j >= 0; --j)
+        {
+            zuu = zuu * u + zu;
+            zu = zu * u + z;
+            z = z * u + h[j];
+            zuv = zuv * u + zv;
+            zv = zv * u + hv[j];
+            zvv = zvv * u + hvv[j];
+        }
+
+        zuu = 2 * zuu;
+
+        // u and v are affine in x and y
+        d[0] = z;
+        d[1] = ap * zu + cp * zv;
+        d[2] = bp * zu + dp * zv;
+        if (Order > 1)
+        {
+            d[3] = ap * ap * zuu + 2 * ap * cp * zuv + cp * cp * zvv;
+            d[4] = ap * bp * zuu + (ap * dp + bp * cp) * zuv + cp * dp * zvv;
+            d[5] = bp * bp * zuu + 2 * bp * dp * zuv + dp * dp * zvv;
+        }
+    }
+
+    // z[i] = (*this)(x[i], y[i]) for contiguous points, with the coefficients held in registers across
+    // a loop simple enough to vectorize
+    void evaluate (const Real* x, const Real* y, Real* z, std::size_t n) const
+    {
+        const Real c[21] = {p[0], p[1], p[2], p[3], p[4], p[5], p[6], p[7], p[8], p[9], p[10],
+                            p[11], p[12], p[13], p[14], p[15], p[16], p[17], p[18], p[19], p[20]};
+        const Real xc = x0;
+        const Real yc = y0;
+        const Real a = ap;
+        const Real b = bp;
+        const Real cc = cp;
+        const Real d = dp;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const Real dx = x[i] - xc;
+            const Real dy = y[i] - yc;
+            const Real u = a * dx + b * dy;
+            const Real v = cc * dx + d * dy;
+
+            const Real h0 = c[0] + v * (c[1] + v * (c[2] + v * (c[3] + v * (c[4] + v * c[5]))));
+            const Real h1 = c[6] + v * (c[7] + v * (c[8] + v * (c[9] + v * c[10])));
+            const Real h2 = c[11] + v * (c[12] + v * (c[13] + v * c[14]));
+            const Real h3 = c[15] + v * (c[16] + v * c[17]);
+            const Real h4 = c[18] + v * c[19];
+            z[i] = h0 + u * (h1 + u * (h2 + u * (h3 + u * (h4 + u * c[20]))));
+        }
+    }
+
+    // z[stride * i] = (*this)(origin + i * spacing, y) for first <= i < last, the points of a row of a
+    // grid, as evaluate does with the terms in y computed once
+    void evaluate_row (Real origin, Real spacing, std::ptrdiff_t first, std::ptrdiff_t last, Real y, Real* z, std::ptrdiff_t stride) const
+    {
+        const Real c[21] = {p[0], p[1], p[2], p[3], p[4], p[5], p[6], p[7], p[8], p[9], p[10],
+                            p[11], p[12], p[13], p[14], p[15], p[16], p[17], p[18], p[19], p[20]};
+        const Real xc = x0;
+        const Real a = ap;
+        const Real cc = cp;
+        const Real dy = y - y0;
+        const Real by = bp * dy;
+        const Real dyv = dp * dy;
+        for (std::ptrdiff_t i = first; i < last; ++i)
+        {
+            const Real dx = (origin + static_cast<Real>(i) * spacing) - xc;
+            const Real u = a * dx + by;
+            const Real v = cc * dx + dyv;
+
+            const Real h0 = c[0] + v * (c[1] + v * (c[2] + v * (c[3] + v * (c[4] + v * c[5]))));
+            const Real h1 = c[6] + v * (c[7] + v * (c[8] + v * (c[9] + v * c[10])));
+            const Real h2 = c[11] + v * (c[12] + v * (c[13] + v * c[14]));
+            const Real h3 = c[15] + v * (c[16] + v * c[17]);
+            const Real h4 = c[18] + v * c[19];
+            z[stride * i] = h0 + u * (h1 + u * (h2 + u * (h3 + u * (h4 + u * c[20]))));
+        }
+    }
+};
+
+// Fits the quintic in the type of the data, Fit, and stores it in that of the patch, which may be narrower
+template <typename Real, typename Fit>
+void fit_akima_patch (akima_patch<Real>& patch, const Fit (&x)[3], const Fit (&y)[3], const Fit (&z)[3], const Fit* const (&d)[3])
+{
+    akima_patch<Fit> fitted {};
+    fitted.fit(x, y, z, d);
+    patch.assign(fitted);
+}
+
+template <typename Real>
+void fit_akima_patch (akima_patch<Real>& patch, const Real (&x)[3], const Real (&y)[3], const Real (&z)[3], const Real* const (&d)[3])
+{
+    patch.fit(x, y, z, d);
+}
+
+// The working space of one sequence of estimates, so that concurrent sequences share nothing
+template <typename Real, typename Index>
+struct akima_scratch
+{
+    std::vector<std::pair<Real, Index>> heap;
+    std::vector<Index> nodes;
+    std::vector<Index> ring;
+    std::vector<Real> matrix;
+    std::vector<Real> rhs;
+    std::vector<Real> solution;
+
+    // The nodes seen by one search, in an open addressing table at most half full, which stays
+    // small however large the triangulation
+    std::vector<Index> seen;
+    std::size_t seen_count = 0;
+
+    static constexpr Index npos = static_cast<Index>(-1);
+
+    void clear_seen (std::size_t expected)
+    {
+        std::size_t size = 64;
+        while (size < 2 * expected)
+        {
+            size *= 2;
+        }
+        seen.assign((std::max)(size, seen.size()), npos);
+        seen_count = 0;
+    }
+
+    // False if w was seen already
+    bool see (Index w)
+    {
+        if (2 * (seen_count + 1) > seen.size())
+        {
+            std::vector<Index> old(2 * seen.size(), npos);
+            old.swap(seen);
+            seen_count = 0;
+            for (const Index u : old)
+            {
+                if (u != npos)
+                {
+                    see(u);
+                }
+            }
+        }
+
+        const std::size_t mask = seen.size() - 1;
+        for (std::size_t h = static_cast<std::size_t>(static_cast<std::uint64_t>(w) * 0x9E3779B97F4A7C15u >> 32) & mask; ; h = (h + 1) & mask)
+        {
+            if (seen[h] == w)
+            {
+                return false;
+            }
+            if (seen[h] == npos)
+            {
+                seen[h] = w;
+                ++seen_count;
+                return true;
+            }
+        }
+    }
+};
+
+template <typename Real, typename Index>
+constexpr Index akima_scratch<Real, Index>::npos;
+
+// Householder QR of the column-major rows by columns matrix, applied to the channels right hand sides;
+// false if it is numerically rank deficient
+template <typename Real, typename Index>
+bool akima_least_squares (Index rows, int columns, std::size_t channels, akima_scratch<Real, Index>& s)
+{
+    using std::sqrt;
+
+    Real* a = s.matrix.data();
+    s.solution.assign(9 * channels, Real(0));
+    const Real tolerance = sqrt(std::numeric_limits<Real>::epsilon());
+    Real largest = 0;
+    Real diagonal[9];
+    for (int j = 0; j < columns; ++j)
+    {
+        Real* column = a + j * rows;
+        Real norm = 0;
+        for (Index r = j; r < rows; ++r)
+        {
+            norm += column[r] * column[r];
+        }
+        norm = sqrt(norm);
+        largest = (std::max)(largest, norm);
+        if (!(norm > tolerance * largest))
+        {
+            return false;
+        }
+
+        const Real alpha = column[j] > 0 ? -norm : norm;
+        column[j] -= alpha;
+        Real vnorm2 = 0;
+        for (Index r = j; r < rows; ++r)
+        {
+            vnorm2 += column[r] * column[r];
+        }
+        diagonal[j] = alpha;
+
+        for (int k = j + 1; k < columns; ++k)
+        {
+            Real* other = a + k * rows;
+            Real dot = 0;
+            for (Index r = j; r < rows; ++r)
+            {
+                dot += column[r] * other[r];
+            }
+            const Real f = 2 * dot / vnorm2;
+            for (Index r = j; r < rows; ++r)
+            {
+                other[r] -= f * column[r];
+            }
+        }
+
+        for (std::size_t c = 0; c < channels; ++c)
+        {
+            Real* b = &s.rhs[c * rows];
+            Real dot = 0;
+            for (Index r = j; r < rows; ++r)
+            {
+                dot += column[r] * b[r];
+            }
+            const Real f = 2 * dot / vnorm2;
+            for (Index r = j; r < rows; ++r)
+            {
+                b[r] -= f * column[r];
+            }
+        }
+    }
+
+    for (std::size_t c = 0; c < channels; ++c)
+    {
+        const Real* b = &s.rhs[c * rows];
+        Real* solution = &s.solution[9 * c];
+        for (int j = columns - 1; j >= 0; --j)
+        {
+            Real sum = b[j];
+            for (int k = j + 1; k < columns; ++k)
+            {
+                sum -= a[k * rows + j] * solution[k];
+            }
+            solution[j] = sum / diagonal[j];
+        }
+    }
+
+    return true;
+}
+
+// Least squares fit of a cubic through (x(v), y(v), z(v, c)) to the rows nodes of the neighborhood of v,
+// the farthest at the squared distance radius2, weighted by the inverse squared distance, which is exact
+// for cubic data like the estimates of Algorithm 761. Too few nodes or nodes close to a conic give way
+// to a quadratic, and nodes close to a line to a plane. The matrix depends on the nodes alone, so one
+// factorization serves all channels. Writes z_x, z_y, z_xx, z_xy, z_yy of each channel to d.
+template <typename Real, typename Index, typename X, typename Y, typename Z>
+void estimate_akima_derivatives (Index v, const Index* nodes, Index rows, Real radius2, std::size_t channels, X x, Y y, Z z,
+                                 akima_scratch<Real, Index>& s, Real* d)
+{
+    using std::sqrt;
+
+    const Real px = x(v);
+    const Real py = y(v);
+    const Real h = sqrt(radius2);
+
+    std::fill(d, d + 5 * channels, Real(0));
+    for (const int columns : {9, 5, 2})
+    {
+        if (rows < static_cast<Index>(columns))
+        {
+            continue;
+        }
+
+        // Columns z_x h, z_y h, z_xx h^2 / 2, z_xy h^2, z_yy h^2 / 2, then the cubic terms
+        s.matrix.resize(rows * columns);
+        s.rhs.resize(rows * channels);
+        for (Index r = 0; r < rows; ++r)
+        {
+            const Index u = nodes[r];
+            const Real dx = (x(u) - px) / h;
+            const Real dy = (y(u) - py) / h;
+            const Real w = 1 / (dx * dx + dy * dy);
+            const Real terms[9] = {dx, dy, dx * dx, dx * dy, dy * dy, dx * dx * dx, dx * dx * dy, dx * dy * dy, dy * dy * dy};
+            for (int j = 0; j < columns; ++j)
+            {
+                s.matrix[j * rows + r] = w * terms[j];
+            }
+            for (std::size_t c = 0; c < channels; ++c)
+            {
+                s.rhs[c * rows + r] = w * (z(u, c) - z(v, c));
+            }
+        }
+
+        if (akima_least_squares(rows, columns, channels, s))
+        {
+            for (std::size_t c = 0; c < channels; ++c)
+            {
+                const Real* solution = &s.solution[9 * c];
+                Real* dc = d + 5 * c;
+                dc[0] = solution[0] / h;
+                dc[1] = solution[1] / h;
+                if (columns > 2)
+                {
+                    dc[2] = 2 * solution[2] / (h * h);
+                    dc[3] = solution[3] / (h * h);
+                    dc[4] = 2 * solution[4] / (h * h);
+                }
+            }
+            return;
+        }
+    }
+}
+
+template <class RandomAccessContainer, class Index = std::uint32_t, class Statistics = no_statistics>
+class bivariate_akima_detail
+{
+public:
+    using Real = typename RandomAccessContainer::value_type;
+    using triangulation_type = triangulation<Real, Index, std::allocator<Real>, Statistics>;
+    using index_type = typename triangulation_type::index_type;
+
+    // The type in which the derivatives are estimated and the quintics fitted, the predicate_type of the
+    // triangulation: double for float nodes and values, so that float storage rounds the coefficients of
+    // the quintics rather than the least squares and the fits that produce them
+    using fit_type = typename boost::math::tools::promote_args<Real, double>::type;
+
+    // The triangle found by the previous query of one thread, where its next query starts
+    struct hint_type
+    {
+        index_type triangle = triangulation_type::npos;
+
+        // The cell of the location index containing the previous query
+        std::size_t cell = static_cast<std::size_t>(-1);
+    };
+
+    // z[channels * i + c] is the value of channel c at node i. Containers that are std::vector<Real> become
+    // the storage of the nodes and values as they are; others are copied.
+    bivariate_akima_detail (RandomAccessContainer&& x, RandomAccessContainer&& y, RandomAccessContainer&& z, std::size_t channels, std::size_t nearest)
+        : z_ {values_type::adopt(std::move(z))}, triangulation_ {values_type::adopt(std::move(x)), values_type::adopt(std::move(y))}, channels_ {channels}
+    {
+        sequential_executor executor;
+        fit(nearest, executor);
+    }
+
+    // Triangulates, estimates the derivatives and fits the quintics as tasks of the executor
+    template <typename Executor>
+    bivariate_akima_detail (Executor&& executor, RandomAccessContainer&& x, RandomAccessContainer&& y, RandomAccessContainer&& z, std::size_t channels, std::size_t nearest)
+        : z_ {values_type::adopt(std::move(z))}, triangulation_ {values_type::adopt(std::move(x)), values_type::adopt(std::move(y)), executor}, channels_ {channels}
+    {
+        fit(nearest, executor);
+    }
+
+    // Reads the n nodes and the channels * n values in place: they must outlive the interpolator and not
+    // change, and nodes cannot be inserted or erased. A refit adopts its values.
+    bivariate_akima_detail (borrow_nodes_t, const Real* x, const Real* y, const Real* z, std::size_t n, std::size_t channels, std::size_t nearest)
+        : z_ {z, channels * n}, triangulation_ {borrow_nodes, x, y, n}, channels_ {channels}
+    {
+        sequential_executor executor;
+        fit(nearest, executor);
+    }
+
+    template <typename Executor>
+    bivariate_akima_detail (Executor&& executor, borrow_nodes_t, const Real* x, const Real* y, const Real* z, std::size_t n, std::size_t channels, std::size_t nearest)
+        : z_ {z, channels * n}, triangulation_ {borrow_nodes, x, y, n, executor}, channels_ {channels}
+    {
+        fit(nearest, executor);
+    }
+
+    // Each thread resumes from the triangle of its own previous query of this interpolator, as long as
+    // the triangles have not changed since
+    hint_type& thread_hint () const
+    {
+        return detail::thread_hint<hint_type>(generation_);
+    }
+
+    Real operator() (Real x, Real y) const
+    {
+        return (*this)(x, y, thread_hint());
+    }
+
+    // The first channel
+    Real operator() (Real x, Real y, hint_type& hint) const
+    {
+        const index_type t = locate(x, y, hint);
+        if (triangulation_.is_ghost(t))
+        {
+            return std::numeric_limits<Real>::quiet_NaN();
+        }
+
+        return patches_[channels_ * t](x, y);
+    }
+
+    // Writes the values of the channels at (x, y), from the quintics of one triangle, which are adjacent
+    template <typename OutputIter>
+    OutputIter channel_values (Real x, Real y, hint_type& hint, OutputIter out) const
+    {
+        const index_type t = locate(x, y, hint);
+        const bool ghost = triangulation_.is_ghost(t);
+        for (std::size_t c = 0; c < channels_; ++c)
+        {
+            *out = ghost ? std::numeric_limits<Real>::quiet_NaN() : patches_[channels_ * t + c](x, y);
+            ++out;
+        }
+        return out;
+    }
+
+    // Writes the value and the derivatives up to Order of each channel at (x, y), as akima_patch::derivatives
+    // does, 3 or 6 outputs for each channel in turn
+    template <int Order, typename OutputIter>
+    OutputIter channel_derivatives (Real x, Real y, hint_type& hint, OutputIter out) const
+    {
+        constexpr int outputs = Order == 1 ? 3 : 6;
+        const index_type t = locate(x, y, hint);
+        const bool ghost = triangulation_.is_ghost(t);
+        Real d[outputs] = {};
+        for (std::size_t c = 0; c < channels_; ++c)
+        {
+            if (ghost)
+            {
+                std::fill(d, d + outputs, std::numeric_limits<Real>::quiet_NaN());
+            }
+            else
+            {
+                patches_[channels_ * t + c].template derivatives<Order>(x, y, d);
+            }
+            out = std::copy(d, d + outputs, out);
+        }
+        return out;
+    }
+
+    // Writes the values of the channels at (x, y) interpolated linearly in the triangle holding it, NaN
+    // outside of the convex hull: the cheapest C0 surface on the triangulation, from one location, the
+    // affine coordinates of the quintics there and the values at three nodes
+    template <typename OutputIter>
+    OutputIter linear_values (Real x, Real y, hint_type& hint, OutputIter out) const
+    {
+        const index_type t = locate(x, y, hint);
+        if (triangulation_.is_ghost(t))
+        {
+            return std::fill_n(out, channels_, std::numeric_limits<Real>::quiet_NaN());
+        }
+
+        return interpolate_linearly(t, x, y, out);
+    }
+
+    // Writes the values of the channels at (x, y) by Sibson's natural neighbor interpolation, NaN outside
+    // of the convex hull. The weight of a node is the area that the Voronoi cell of (x, y) would take from
+    // the cell of the node if (x, y) were inserted, which the triangles whose circumcircles hold (x, y)
+    // give without changing the triangulation: the cell of (x, y) is cut off by the circumcenters of those
+    // triangles and of the triangles that (x, y) would form with the edges of their boundary. The surface
+    // is C1 except at the nodes, where it is C0, and reproduces linear data. On the convex hull, where the
+    // cell of (x, y) is unbounded, the weights are their limit, those of linear interpolation. Each thread
+    // keeps the triangles of the last query in scratch space, which grows to the most it has needed.
+    template <typename OutputIter>
+    OutputIter natural_neighbor_values (Real x, Real y, hint_type& hint, OutputIter out) const
+    {
+        const index_type t = locate(x, y, hint);
+        if (triangulation_.is_ghost(t))
+        {
+            return std::fill_n(out, channels_, std::numeric_limits<Real>::quiet_NaN());
+        }
+        for (int i = 0; i < 3; ++i)
+        {
+            const index_type v = triangulation_.vertex(t, i);
+            if (triangulation_.x(v) == x && triangulation_.y(v) == y)
+            {
+                for (std::size_t c = 0; c < channels_; ++c, ++out)
+                {
+                    *out = z_[channels_ * v + c];
+                }
+                return out;
+            }
+        }
+
+        thread_local natural_neighbors s;
+        if (!natural_neighbor_weights(t, x, y, s))
+        {
+            return interpolate_linearly(t, x, y, out);
+        }
+        for (std::size_t c = 0; c < channels_; ++c, ++out)
+        {
+            fit_type sum = 0;
+            for (std::size_t k = 0; k < s.edges.size(); ++k)
+            {
+                sum += s.weights[k] * z_[channels_ * s.edges[k][0] + c];
+            }
+            *out = static_cast<Real>(sum);
+        }
+        return out;
+    }
+
+    // Evaluates the queries in the order of a Hilbert curve through their bounding box, so that each walk
+    // starts from the triangle of a nearby query, and evaluates each run of queries in one triangle together.
+    // With Order 1 or 2, writes the value and the derivatives of the first channel at query i to out[3 * i]
+    // or out[6 * i] on, as akima_patch::derivatives does.
+    template <int Order = 0, class InputContainer, class OutputContainer>
+    void evaluate (const InputContainer& xs, const InputContainer& ys, OutputContainer& out) const
+    {
+        constexpr std::size_t outputs = Order == 0 ? 1 : Order == 1 ? 3 : 6;
+        const auto n = static_cast<std::size_t>(xs.size());
+        if (n != static_cast<std::size_t>(ys.size()) || outputs * n != static_cast<std::size_t>(out.size()))
+        {
+            std::ostringstream oss;
+            oss << "There must be the same number of abscissas and ordinates, and " << outputs << " outputs for each, but there are "
+                << n << ", " << ys.size() << " and " << out.size() << ".";
+            throw std::domain_error(oss.str());
+        }
+        if (n == 0)
+        {
+            return;
+        }
+
+        const auto x = std::cbegin(xs);
+        const auto y = std::cbegin(ys);
+        const auto result = std::begin(out);
+        // Counting sort into the cells of a coarse Hilbert curve with about 64 queries per cell,
+        // which keeps the input order within a cell
+        const hilbert_grid<Real> grid(x, y, n);
+        int level = 1;
+        while (level < 8 && (static_cast<std::size_t>(64) << (2 * level)) < n)
+        {
+            ++level;
+        }
+        std::vector<std::size_t> offsets((static_cast<std::size_t>(1) << (2 * level)) + 1, 0);
+        std::vector<std::uint32_t> cells(n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            cells[i] = static_cast<std::uint32_t>(grid(x[i], y[i], level));
+            ++offsets[cells[i] + 1];
+        }
+        std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+        std::vector<std::size_t> order(n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            order[offsets[cells[i]]++] = i;
+        }
+
+        // Blocks of queries in that order are located, carrying the triangle from one query to the
+        // next, then evaluated run by run with the coefficients of the triangle held in registers
+        constexpr std::size_t block = 64;
+        Real bx[block];
+        Real by[block];
+        Real bz[outputs * block];
+        index_type bt[block];
+        hint_type hint;
+        for (std::size_t k = 0; k < n; k += block)
+        {
+            const std::size_t m = (std::min)(block, n - k);
+            for (std::size_t j = 0; j < m; ++j)
+            {
+                const std::size_t i = order[k + j];
+                bx[j] = x[i];
+                by[j] = y[i];
+                bt[j] = locate(bx[j], by[j], hint);
+            }
+
+            std::size_t first = 0;
+            while (first < m)
+            {
+                const index_type current = bt[first];
+                std::size_t last = first + 1;
+                while (last < m && bt[last] == current)
+                {
+                    ++last;
+                }
+
+                if (triangulation_.is_ghost(current))
+                {
+                    std::fill(bz + outputs * first, bz + outputs * last, std::numeric_limits<Real>::quiet_NaN());
+                }
+                else if (Order == 0)
+                {
+                    patches_[channels_ * current].evaluate(bx + first, by + first, bz + first, last - first);
+                }
+                else
+                {
+                    const akima_patch<Real>& patch = patches_[channels_ * current];
+                    for (std::size_t j = first; j < last; ++j)
+                    {
+                        patch.template derivatives<Order == 0 ? 1 : Order>(bx[j], by[j], bz + outputs * j);
+                    }
+                }
+                first = last;
+            }
+
+            for (std::size_t j = 0; j < m; ++j)
+            {
+                std::copy(bz + outputs * j, bz + outputs * (j + 1), result + static_cast<std::ptrdiff_t>(outputs * order[k + j]));
+            }
+        }
+    }
+
+    // Writes the values of channel c on the grid, NaN outside of the convex hull, triangle by triangle
+    // rather than point by point: the grid is cut into tiles of 64 by 64 points, which are the tasks of
+    // the executor, and each triangle is scan converted in each tile it overlaps, a row at a time, with
+    // no point location. The points of a triangle are those that the exact orientation tests place in
+    // it, and its value there is that of operator() in it; a point on an edge takes the value of either
+    // triangle. Where the triangles outnumber the points, visiting them costs more than locating each
+    // point from the previous one, which the tiles do instead. Each tile writes only its own points, and
+    // the result is the same for any executor.
+    template <typename Executor>
+    void rasterize (const grid_spec<Real>& grid, std::size_t c, Real* out, Executor& executor) const
+    {
+        using std::isfinite;
+        if (!(grid.dx != 0 && grid.dy != 0 && isfinite(grid.dx) && isfinite(grid.dy) && isfinite(grid.x0) && isfinite(grid.y0)))
+        {
+            std::ostringstream oss;
+            oss << "The grid must have finite origin and nonzero finite spacings, but has origin (" << grid.x0 << ", " << grid.y0
+                << ") and spacings " << grid.dx << " and " << grid.dy << ".";
+            throw std::domain_error(oss.str());
+        }
+        if (c >= channels_)
+        {
+            std::ostringstream oss;
+            oss << "Channel " << c << " is not a channel of the interpolator, which has " << channels_ << ".";
+            throw std::domain_error(oss.str());
+        }
+        if (grid.columns == 0 || grid.rows == 0)
+        {
+            return;
+        }
+
+        // The triangles overlapping each tile, by the bounding boxes of their points, in CSR
+        constexpr std::size_t tile = 64;
+        const std::size_t tile_columns = (grid.columns + tile - 1) / tile;
+        const std::size_t tile_rows = (grid.rows + tile - 1) / tile;
+        const index_type triangles = triangulation_.triangle_count();
+        auto tile_area = [&](std::size_t k, std::size_t (&area)[4])
+        {
+            area[0] = (k % tile_columns) * tile;
+            area[1] = (std::min)((k % tile_columns + 1) * tile, grid.columns) - 1;
+            area[2] = (k / tile_columns) * tile;
+            area[3] = (std::min)((k / tile_columns + 1) * tile, grid.rows) - 1;
+        };
+        if (static_cast<std::size_t>(triangles) > grid.columns * grid.rows)
+        {
+            executor(tile_columns * tile_rows, [&](std::size_t k)
+            {
+                std::size_t area[4];
+                tile_area(k, area);
+                hint_type hint;
+                for (std::size_t j = area[2]; j <= area[3]; ++j)
+                {
+                    const Real y = grid.y0 + static_cast<Real>(j) * grid.dy;
+                    for (std::size_t i = area[0]; i <= area[1]; ++i)
+                    {
+                        const Real x = grid.x0 + static_cast<Real>(i) * grid.dx;
+                        const index_type t = locate(x, y, hint);
+                        out[static_cast<std::ptrdiff_t>(j) * grid.row_stride + static_cast<std::ptrdiff_t>(i) * grid.column_stride] =
+                            triangulation_.is_ghost(t) ? std::numeric_limits<Real>::quiet_NaN() : patches_[channels_ * t + c](x, y);
+                    }
+                }
+            });
+            return;
+        }
+
+        std::vector<std::size_t> boxes(4 * static_cast<std::size_t>(triangles));
+        std::vector<std::size_t> offsets(tile_columns * tile_rows + 1, 0);
+        for (index_type t = 0; t < triangles; ++t)
+        {
+            std::size_t* box = &boxes[4 * static_cast<std::size_t>(t)];
+            if (triangulation_.is_ghost(t) || !raster_box(grid, t, box))
+            {
+                box[0] = 1;
+                box[1] = 0;
+            }
+        }
+        auto for_each_tile = [&](index_type t, auto f)
+        {
+            const std::size_t* box = &boxes[4 * static_cast<std::size_t>(t)];
+            if (box[0] <= box[1])
+            {
+                for (std::size_t tr = box[2] / tile; tr <= box[3] / tile; ++tr)
+                {
+                    for (std::size_t tc = box[0] / tile; tc <= box[1] / tile; ++tc)
+                    {
+                        f(tr * tile_columns + tc);
+                    }
+                }
+            }
+        };
+        for (index_type t = 0; t < triangles; ++t)
+        {
+            for_each_tile(t, [&offsets](std::size_t k) { ++offsets[k + 1]; });
+        }
+        std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+        std::vector<index_type> binned(offsets.back());
+        {
+            std::vector<std::size_t> next(offsets.begin(), offsets.end() - 1);
+            for (index_type t = 0; t < triangles; ++t)
+            {
+                for_each_tile(t, [&](std::size_t k) { binned[next[k]++] = t; });
+            }
+        }
+
+        executor(tile_columns * tile_rows, [&](std::size_t k)
+        {
+            std::size_t area[4];
+            tile_area(k, area);
+            for (std::size_t j = area[2]; j <= area[3]; ++j)
+            {
+                for (std::size_t i = area[0]; i <= area[1]; ++i)
+                {
+                    out[static_cast<std::ptrdiff_t>(j) * grid.row_stride + static_cast<std::ptrdiff_t>(i) * grid.column_stride] =
+                        std::numeric_limits<Real>::quiet_NaN();
+                }
+            }
+            for (std::size_t b = offsets[k]; b < offsets[k + 1]; ++b)
+            {
+                rasterize_triangle(grid, binned[b], c, &boxes[4 * static_cast<std::size_t>(binned[b])], area, out);
+            }
+        });
+    }
+
+    // z[c] is the value of channel c at (x, y)
+    template <typename InputIter>
+    index_type insert (Real x, Real y, InputIter z)
+    {
+        const index_type v = grid_.empty() ? triangulation_.add_node(x, y) : triangulation_.add_node(x, y, grid_.seed(x, y));
+        generation_ = next_generation();
+        location_index_changed();
+        for (std::size_t c = 0; c < channels_; ++c, ++z)
+        {
+            z_.push_back(*z);
+        }
+        derivatives_.resize(5 * channels_ * triangulation_.size());
+        neighborhoods_.resize(nearest_ * triangulation_.size());
+        radius_.resize(triangulation_.size());
+        if (refit_all())
+        {
+            return v;
+        }
+
+        derivative_scratch s;
+        std::vector<index_type> nodes = reverse_nearest(v, s);
+        nodes.push_back(v);
+        refit(nodes, std::vector<index_type>(), s);
+        return v;
+    }
+
+    void erase (index_type v)
+    {
+        if (v >= triangulation_.size())
+        {
+            std::ostringstream oss;
+            oss << "Node " << v << " is not a node of the interpolator, which has " << triangulation_.size() << " nodes.";
+            throw std::domain_error(oss.str());
+        }
+
+        // The nodes near the removed one, and those near the last one, whose neighborhoods refer to it
+        derivative_scratch s;
+        std::vector<index_type> nodes = reverse_nearest(v, s);
+        const index_type last = triangulation_.size() - 1;
+        const std::vector<index_type> referring = v != last ? reverse_nearest(last, s) : std::vector<index_type>();
+        std::vector<index_type> triangles;
+        triangulation_.remove_node(v, std::back_inserter(triangles));
+        generation_ = next_generation();
+        location_index_changed();
+
+        const index_type values = 5 * channels_;
+        if (v != last)
+        {
+            for (std::size_t c = 0; c < channels_; ++c)
+            {
+                z_.set(channels_ * v + c, z_[channels_ * last + c]);
+            }
+            std::copy(derivatives_.begin() + values * last, derivatives_.begin() + values * (last + 1), derivatives_.begin() + values * v);
+            std::copy(neighborhoods_.begin() + nearest_ * last, neighborhoods_.begin() + nearest_ * (last + 1), neighborhoods_.begin() + nearest_ * v);
+            radius_[v] = radius_[last];
+            for (const index_type w : referring)
+            {
+                if (w != v)
+                {
+                    std::replace(neighborhoods_.begin() + nearest_ * w, neighborhoods_.begin() + nearest_ * (w + 1), last, v);
+                }
+            }
+            std::replace(nodes.begin(), nodes.end(), last, v);
+        }
+        for (std::size_t c = 0; c < channels_; ++c)
+        {
+            z_.pop_back();
+        }
+        derivatives_.resize(values * last);
+        neighborhoods_.resize(nearest_ * last);
+        radius_.resize(last);
+        if (refit_all())
+        {
+            return;
+        }
+
+        refit(nodes, triangles, s);
+    }
+
+    // Replaces the values and fits them on the same nodes, whose neighborhoods were kept
+    template <typename Executor>
+    void refit (RandomAccessContainer&& z, Executor& executor)
+    {
+        if (z.size() != z_.size())
+        {
+            std::ostringstream oss;
+            oss << "There must be " << z_.size() << " values, one for each channel at each node, but there are " << z.size() << ".";
+            throw std::domain_error(oss.str());
+        }
+
+        z_ = values_type(values_type::adopt(std::move(z)));
+        fit_values(executor, hilbert_order());
+    }
+
+    void index_locations (double cells_per_node)
+    {
+        grid_ = location_grid<Real, Index>(triangulation_, cells_per_node);
+        generation_ = next_generation();
+        cells_per_node_ = cells_per_node;
+        changes_ = 0;
+    }
+
+    const location_grid<Real, Index>& get_location_index () const
+    {
+        return grid_;
+    }
+
+    const triangulation_type& get_triangulation () const
+    {
+        return triangulation_;
+    }
+
+    std::size_t channels () const
+    {
+        return channels_;
+    }
+
+    // z_x, z_y, z_xx, z_xy, z_yy of channel c at node v
+    const fit_type* derivatives (index_type v, index_type c = 0) const
+    {
+        return &derivatives_[5 * (channels_ * v + c)];
+    }
+
+    // The nearest nodes of node v, nearest first, from which its derivatives are estimated
+    const index_type* neighborhood (index_type v) const
+    {
+        return &neighborhoods_[nearest_ * v];
+    }
+
+    std::size_t neighborhood_size () const
+    {
+        return nearest_;
+    }
+
+    // The seconds are those of the fits of all nodes, by the constructors and refit
+    bivariate_akima_statistics statistics () const
+    {
+        bivariate_akima_statistics s = phases_;
+        s.triangulation = triangulation_.statistics();
+        return s;
+    }
+
+    void reset_statistics ()
+    {
+        phases_ = bivariate_akima_statistics();
+        triangulation_.reset_statistics();
+    }
+
+    // The memory held, including the nodes and values unless they are borrowed
+    std::size_t bytes () const
+    {
+        return z_.capacity() * sizeof(Real) + triangulation_.bytes() + grid_.bytes() +
+               neighborhoods_.capacity() * sizeof(index_type) + (radius_.capacity() + derivatives_.capacity()) * sizeof(fit_type) +
+               patches_.capacity() * sizeof(akima_patch<Real>) + sizeof(*this);
+    }
+
+    // The quintic of channel c on triangle t is patches()[channels() * t + c]
+    const akima_patch<Real>* patches () const
+    {
+        return patches_.data();
+    }
+
+private:
+    using derivative_scratch = akima_scratch<fit_type, index_type>;
+    using values_type = node_array<Real>;
+
+    // The neighbors of each node, CSR-style, for the nearest node searches of the initial fit; the
+    // searches after an update read the triangulation instead
+    struct adjacency
+    {
+        std::vector<index_type> offsets;
+        std::vector<index_type> nodes;
+    };
+
+    // Runs f(first, last) on consecutive chunks of the nodes in the given order as tasks of the executor
+    template <typename Executor, typename F>
+    static void for_each_chunk (Executor& executor, const std::vector<index_type>& order, F f)
+    {
+        constexpr index_type chunk = 4096;
+        const auto n = static_cast<index_type>(order.size());
+        executor(static_cast<std::size_t>((n + chunk - 1) / chunk), [&](std::size_t k)
+        {
+            const index_type first = static_cast<index_type>(k) * chunk;
+            f(order.begin() + static_cast<std::ptrdiff_t>(first), order.begin() + static_cast<std::ptrdiff_t>((std::min)(n, first + chunk)));
+        });
+    }
+
+    // Finds the neighborhoods of the nodes, then fits the values. The tasks take consecutive nodes along
+    // a Hilbert curve, for locality, and each has its own scratch space; as every result depends on its
+    // node alone, the results are bitwise the same for any executor.
+    template <typename Executor>
+    void fit (std::size_t nearest, Executor& executor)
+    {
+        if (channels_ == 0)
+        {
+            throw std::domain_error("There must be at least one channel.");
+        }
+        if (static_cast<std::size_t>(triangulation_.size()) * channels_ != z_.size())
+        {
+            std::ostringstream oss;
+            oss << "There must be " << channels_ << " values at each of the " << triangulation_.size() << " nodes, but there are " << z_.size() << " values.";
+            throw std::domain_error(oss.str());
+        }
+        if (nearest < 2)
+        {
+            std::ostringstream oss;
+            oss << "At least 2 nearest nodes are required to estimate the derivatives, but " << nearest << " were requested.";
+            throw std::domain_error(oss.str());
+        }
+
+        const index_type n = triangulation_.size();
+        requested_nearest_ = nearest;
+        nearest_ = (std::min)(requested_nearest_, static_cast<std::size_t>(n - 1));
+        neighborhoods_.resize(nearest_ * n);
+        radius_.resize(n);
+        phase_timer<Statistics> neighborhoods(phases_.neighborhood_seconds);
+        const std::vector<index_type> order = hilbert_order();
+
+        adjacency arcs;
+        arcs.offsets.assign(n + 1, 0);
+        for_each_chunk(executor, order, [this, &arcs](auto first, auto last)
+        {
+            std::vector<index_type> ring;
+            for (; first != last; ++first)
+            {
+                ring.clear();
+                triangulation_.neighbors(*first, std::back_inserter(ring));
+                arcs.offsets[*first + 1] = static_cast<index_type>(ring.size());
+            }
+        });
+        std::partial_sum(arcs.offsets.begin(), arcs.offsets.end(), arcs.offsets.begin());
+        arcs.nodes.resize(arcs.offsets.back());
+        for_each_chunk(executor, order, [this, &arcs](auto first, auto last)
+        {
+            for (; first != last; ++first)
+            {
+                triangulation_.neighbors(*first, arcs.nodes.begin() + static_cast<std::ptrdiff_t>(arcs.offsets[*first]));
+            }
+        });
+
+        for_each_chunk(executor, order, [this, &arcs](auto first, auto last)
+        {
+            derivative_scratch scratch;
+            for (; first != last; ++first)
+            {
+                find_neighborhood(*first, scratch, &arcs);
+            }
+        });
+        neighborhoods.stop();
+
+        fit_values(executor, order);
+    }
+
+    // Estimates the derivatives at the nodes from their neighborhoods and fits the quintics
+    template <typename Executor>
+    void fit_values (Executor& executor, const std::vector<index_type>& order)
+    {
+        phase_timer<Statistics> derivatives(phases_.derivative_seconds);
+        derivatives_.resize(5 * channels_ * triangulation_.size());
+        for_each_chunk(executor, order, [this](auto first, auto last)
+        {
+            derivative_scratch scratch;
+            for (; first != last; ++first)
+            {
+                estimate_derivatives(*first, scratch);
+            }
+        });
+        derivatives.stop();
+
+        const phase_timer<Statistics> patches(phases_.patch_seconds);
+        constexpr index_type chunk = 4096;
+        const index_type triangles = triangulation_.triangle_count();
+        patches_.resize(channels_ * triangles);
+        executor(static_cast<std::size_t>((triangles + chunk - 1) / chunk), [this, triangles](std::size_t k)
+        {
+            const index_type first = static_cast<index_type>(k) * chunk;
+            for (index_type t = first; t < (std::min)(triangles, first + chunk); ++t)
+            {
+                fit_patches(t);
+            }
+        });
+    }
+
+    // The location index seeds its cells with triangles by number, which erase reuses, and covers the
+    // bounding box of the nodes it was built on, so it goes stale as nodes come and go. It is rebuilt once
+    // the changes since it was built reach a sixteenth of the nodes, which keeps its probes short for an
+    // amortized cost of a few cells per change.
+    void location_index_changed ()
+    {
+        if (!grid_.empty() && ++changes_ >= (std::max)(static_cast<std::size_t>(64), static_cast<std::size_t>(triangulation_.size()) / 16))
+        {
+            index_locations(cells_per_node_);
+        }
+    }
+
+    // After a node is added or removed, the nodes where fewer nodes are available than requested all
+    // change their neighborhoods, so everything is fitted again
+    bool refit_all ()
+    {
+        if ((std::min)(requested_nearest_, static_cast<std::size_t>(triangulation_.size() - 1)) == nearest_)
+        {
+            return false;
+        }
+
+        sequential_executor executor;
+        fit(requested_nearest_, executor);
+        return true;
+    }
+
+    // The nodes other than p that have p among their nearest nodes, or would have if it were not there
+    // yet. Such a node w is joined to p by a path of arcs through nodes nearer to w than p, which has at
+    // most nearest_ arcs, so a search of as many arcs from p finds them all.
+    std::vector<index_type> reverse_nearest (index_type p, derivative_scratch& s) const
+    {
+        std::vector<index_type> result;
+        std::vector<index_type> frontier {p};
+        std::vector<index_type> next;
+        s.clear_seen(8 * nearest_ * nearest_);
+        s.see(p);
+        for (index_type hops = 0; hops < nearest_ && !frontier.empty(); ++hops)
+        {
+            next.clear();
+            for (const index_type u : frontier)
+            {
+                s.ring.clear();
+                triangulation_.neighbors(u, std::back_inserter(s.ring));
+                for (const index_type w : s.ring)
+                {
+                    if (s.see(w))
+                    {
+                        next.push_back(w);
+                        const fit_type dx = static_cast<fit_type>(triangulation_.x(p)) - triangulation_.x(w);
+                        const fit_type dy = static_cast<fit_type>(triangulation_.y(p)) - triangulation_.y(w);
+                        if (dx * dx + dy * dy <= radius_[w])
+                        {
+                            result.push_back(w);
+                        }
+                    }
+                }
+            }
+            frontier.swap(next);
+        }
+        return result;
+    }
+
+    // Finds the neighborhoods of the nodes and estimates their derivatives again, then fits the quintics
+    // of the triangles around them and of the given ones
+    void refit (const std::vector<index_type>& nodes, std::vector<index_type> triangles, derivative_scratch& s)
+    {
+        for (const index_type v : nodes)
+        {
+            find_neighborhood(v, s, nullptr);
+            estimate_derivatives(v, s);
+        }
+        for (const index_type v : nodes)
+        {
+            triangulation_.incident_triangles(v, std::back_inserter(triangles));
+        }
+        std::sort(triangles.begin(), triangles.end());
+        triangles.erase(std::unique(triangles.begin(), triangles.end()), triangles.end());
+
+        patches_.resize(channels_ * triangulation_.triangle_count());
+        for (const index_type t : triangles)
+        {
+            fit_patches(t);
+        }
+    }
+
+    std::vector<index_type> hilbert_order () const
+    {
+        const index_type n = triangulation_.size();
+        std::vector<index_type> nodes(n);
+        for (index_type v = 0; v < n; ++v)
+        {
+            nodes[v] = v;
+        }
+        const hilbert_grid<Real> grid(triangulation_.x_data(), triangulation_.y_data(), nodes);
+        std::vector<std::pair<std::uint64_t, index_type>> keys(n);
+        for (index_type v = 0; v < n; ++v)
+        {
+            keys[v] = std::make_pair(grid(triangulation_.x(v), triangulation_.y(v)), v);
+        }
+        std::sort(keys.begin(), keys.end());
+        for (index_type v = 0; v < n; ++v)
+        {
+            nodes[v] = keys[v].second;
+        }
+        return nodes;
+    }
+
+    // Walks from the hint while the queries stay in one cell of the location index, if there is one,
+    // and from the seed of the cell otherwise
+    index_type locate (Real x, Real y, hint_type& hint) const
+    {
+        index_type start = hint.triangle;
+        if (!grid_.empty())
+        {
+            const std::size_t c = grid_.cell(x, y);
+            if (c != hint.cell || start == triangulation_type::npos)
+            {
+                start = grid_.seed(x, y);
+                hint.cell = c;
+            }
+        }
+        hint.triangle = triangulation_.locate(x, y, start);
+        return hint.triangle;
+    }
+
+    template <typename OutputIter>
+    OutputIter interpolate_linearly (index_type t, Real x, Real y, OutputIter out) const
+    {
+        const akima_patch<Real>& patch = patches_[channels_ * t];
+        const Real dx = x - patch.x0;
+        const Real dy = y - patch.y0;
+        const Real u = patch.ap * dx + patch.bp * dy;
+        const Real v = patch.cp * dx + patch.dp * dy;
+        const index_type a = triangulation_.vertex(t, 0);
+        const index_type b = triangulation_.vertex(t, 1);
+        const index_type d = triangulation_.vertex(t, 2);
+        for (std::size_t c = 0; c < channels_; ++c, ++out)
+        {
+            const Real z0 = z_[channels_ * a + c];
+            *out = z0 + u * (z_[channels_ * b + c] - z0) + v * (z_[channels_ * d + c] - z0);
+        }
+        return out;
+    }
+
+    // The cavity of an insertion at a query: its triangles and their circumcenters, the edges of its
+    // boundary, counterclockwise, as the first node, the second node and the triangle of the cavity on the
+    // edge, the circumcenter of the triangle of the query with each edge, and the weight of the first node
+    // of each edge
+    struct natural_neighbors
+    {
+        std::vector<index_type> triangles;
+        std::vector<fit_type> circumcenters;
+        std::vector<std::array<index_type, 3>> edges;
+        std::vector<fit_type> centers;
+        std::vector<fit_type> weights;
+    };
+
+    // The Sibson coordinates of (x, y), strictly inside of the real triangle t, with respect to the nodes
+    // of the boundary of the cavity; false where they are not defined, with (x, y) on the convex hull, or
+    // would be lost to rounding
+    bool natural_neighbor_weights (index_type t, Real x, Real y, natural_neighbors& s) const
+    {
+        using std::isfinite;
+        using predicate_type = typename triangulation_type::predicate_type;
+
+        // Coordinates relative to (x, y), where the cell of the query lies
+        const fit_type px = x;
+        const fit_type py = y;
+        auto rx = [&](index_type v) { return static_cast<fit_type>(triangulation_.x(v)) - px; };
+        auto ry = [&](index_type v) { return static_cast<fit_type>(triangulation_.y(v)) - py; };
+
+        auto in_cavity = [&s](index_type u) { return std::find(s.triangles.begin(), s.triangles.end(), u) != s.triangles.end(); };
+        s.triangles.assign(1, t);
+        s.circumcenters.clear();
+        for (std::size_t k = 0; k < s.triangles.size(); ++k)
+        {
+            const index_type a = triangulation_.vertex(s.triangles[k], 0);
+            const index_type b = triangulation_.vertex(s.triangles[k], 1);
+            const index_type c = triangulation_.vertex(s.triangles[k], 2);
+            fit_type ux = 0;
+            fit_type uy = 0;
+            fit_type reach = 0;
+            if (!bounding_circumdisk(rx(a), ry(a), rx(b), ry(b), rx(c), ry(c), ux, uy, reach))
+            {
+                return false;
+            }
+            s.circumcenters.push_back(ux);
+            s.circumcenters.push_back(uy);
+
+            for (int i = 0; i < 3; ++i)
+            {
+                const index_type u = triangulation_.neighbor(s.triangles[k], i);
+                if (!triangulation_.is_ghost(u) && !in_cavity(u))
+                {
+                    const index_type a = triangulation_.vertex(u, 0);
+                    const index_type b = triangulation_.vertex(u, 1);
+                    const index_type c = triangulation_.vertex(u, 2);
+                    if (robust_incircle<predicate_type, Statistics>(triangulation_.x(a), triangulation_.y(a), triangulation_.x(b), triangulation_.y(b),
+                                                        triangulation_.x(c), triangulation_.y(c), x, y) > 0)
+                    {
+                        s.triangles.push_back(u);
+                    }
+                }
+            }
+        }
+
+        // The boundary, chained counterclockwise; each of its nodes is on it once, as the cavity is star
+        // shaped about (x, y)
+        s.edges.clear();
+        for (const index_type r : s.triangles)
+        {
+            for (int i = 0; i < 3; ++i)
+            {
+                const index_type u = triangulation_.neighbor(r, i);
+                if (triangulation_.is_ghost(u) || !in_cavity(u))
+                {
+                    s.edges.push_back({{triangulation_.vertex(r, (i + 1) % 3), triangulation_.vertex(r, (i + 2) % 3), r}});
+                }
+            }
+        }
+        for (std::size_t k = 0; k + 1 < s.edges.size(); ++k)
+        {
+            const index_type to = s.edges[k][1];
+            const auto next = std::find_if(s.edges.begin() + static_cast<std::ptrdiff_t>(k + 1), s.edges.end(),
+                                           [to](const std::array<index_type, 3>& e) { return e[0] == to; });
+            if (next == s.edges.end())
+            {
+                return false;
+            }
+            std::iter_swap(s.edges.begin() + static_cast<std::ptrdiff_t>(k + 1), next);
+        }
+
+        // The circumcenters of the triangles of (x, y) with the edges of the boundary
+        const std::size_t m = s.edges.size();
+        s.centers.resize(2 * m);
+        for (std::size_t k = 0; k < m; ++k)
+        {
+            const index_type a = s.edges[k][0];
+            const index_type b = s.edges[k][1];
+            fit_type reach = 0;
+            if (!(robust_orient2d<predicate_type, Statistics>(x, y, triangulation_.x(a), triangulation_.y(a), triangulation_.x(b), triangulation_.y(b)) > 0) ||
+                !bounding_circumdisk(fit_type(0), fit_type(0), rx(a), ry(a), rx(b), ry(b), s.centers[2 * k], s.centers[2 * k + 1], reach))
+            {
+                return false;
+            }
+        }
+
+        // The area taken from the first node of edge k: the polygon from the circumcenter of edge k
+        // through the circumcenters of the triangles of the cavity about the node, counterclockwise from
+        // the triangle on edge k to that on edge k - 1, to the circumcenter of edge k - 1
+        s.weights.resize(m);
+        fit_type total = 0;
+        for (std::size_t k = 0; k < m; ++k)
+        {
+            const std::size_t previous = (k + m - 1) % m;
+            const index_type v = s.edges[k][0];
+            const fit_type first[2] = {s.centers[2 * k], s.centers[2 * k + 1]};
+            fit_type last[2] = {first[0], first[1]};
+            fit_type sum = 0;
+            index_type r = s.edges[k][2];
+            for (std::size_t steps = 0; ; ++steps)
+            {
+                const auto j = static_cast<std::size_t>(std::find(s.triangles.begin(), s.triangles.end(), r) - s.triangles.begin());
+                if (steps == s.triangles.size() || j == s.triangles.size())
+                {
+                    return false;
+                }
+                const fit_type* u = &s.circumcenters[2 * j];
+                sum += last[0] * u[1] - last[1] * u[0];
+                last[0] = u[0];
+                last[1] = u[1];
+                if (r == s.edges[previous][2])
+                {
+                    break;
+                }
+                const int i = triangulation_.vertex(r, 0) == v ? 0 : triangulation_.vertex(r, 1) == v ? 1 : 2;
+                r = triangulation_.neighbor(r, (i + 1) % 3);
+            }
+            const fit_type end[2] = {s.centers[2 * previous], s.centers[2 * previous + 1]};
+            sum += last[0] * end[1] - last[1] * end[0];
+            sum += end[0] * first[1] - end[1] * first[0];
+            s.weights[k] = sum / 2;
+            total += s.weights[k];
+        }
+        if (!(total > 0 && isfinite(total)))
+        {
+            return false;
+        }
+        for (fit_type& w : s.weights)
+        {
+            w /= total;
+        }
+        return true;
+    }
+
+    // The columns and rows of the grid, box[0] to box[1] and box[2] to box[3], holding the bounding box
+    // of triangle t with a margin of one point; false if there are none
+    bool raster_box (const grid_spec<Real>& grid, index_type t, std::size_t* box) const
+    {
+        using std::ceil;
+        using std::floor;
+        // The margin covers the rounding of the reciprocals of the spacings, too
+        const Real scale[2] = {1 / grid.dx, 1 / grid.dy};
+        Real range[2][2] = {{(std::numeric_limits<Real>::max)(), std::numeric_limits<Real>::lowest()},
+                            {(std::numeric_limits<Real>::max)(), std::numeric_limits<Real>::lowest()}};
+        for (int i = 0; i < 3; ++i)
+        {
+            const index_type v = triangulation_.vertex(t, i);
+            const Real s[2] = {(triangulation_.x(v) - grid.x0) * scale[0], (triangulation_.y(v) - grid.y0) * scale[1]};
+            for (int a = 0; a < 2; ++a)
+            {
+                range[a][0] = (std::min)(range[a][0], s[a]);
+                range[a][1] = (std::max)(range[a][1], s[a]);
+            }
+        }
+        const Real points[2] = {static_cast<Real>(grid.columns), static_cast<Real>(grid.rows)};
+        for (int a = 0; a < 2; ++a)
+        {
+            const Real low = floor(range[a][0]) - 1;
+            const Real high = ceil(range[a][1]) + 1;
+            if (high < 0 || low >= points[a])
+            {
+                return false;
+            }
+            box[2 * a] = low < 0 ? 0 : static_cast<std::size_t>(low);
+            box[2 * a + 1] = high >= points[a] ? (a == 0 ? grid.columns : grid.rows) - 1 : static_cast<std::size_t>(high);
+        }
+        return true;
+    }
+
+    // The points of triangle t, within its box from raster_box, among columns area[0] to area[1] and rows
+    // area[2] to area[3] of the grid: in each row, the span between the crossings of its edges, widened
+    // to whole points and then trimmed by the exact orientation tests, which it holds as the triangle is
+    // convex
+    void rasterize_triangle (const grid_spec<Real>& grid, index_type t, std::size_t c, const std::size_t* box, const std::size_t (&area)[4], Real* out) const
+    {
+        using predicate_type = typename triangulation_type::predicate_type;
+        using std::ceil;
+        using std::floor;
+        const std::size_t first_row = (std::max)(box[2], area[2]);
+        const std::size_t last_row = (std::min)(box[3], area[3]);
+        const std::size_t first_column = (std::max)(box[0], area[0]);
+        const std::size_t last_column = (std::min)(box[1], area[1]);
+        if (first_row > last_row || first_column > last_column)
+        {
+            return;
+        }
+
+        Real vx[3];
+        Real vy[3];
+        for (int i = 0; i < 3; ++i)
+        {
+            vx[i] = triangulation_.x(triangulation_.vertex(t, i));
+            vy[i] = triangulation_.y(triangulation_.vertex(t, i));
+        }
+        const akima_patch<Real>& patch = patches_[channels_ * t + c];
+        for (std::size_t j = first_row; j <= last_row; ++j)
+        {
+            const Real y = grid.y0 + static_cast<Real>(j) * grid.dy;
+            auto inside = [&](std::ptrdiff_t i)
+            {
+                const Real x = grid.x0 + static_cast<Real>(i) * grid.dx;
+                for (int e = 0; e < 3; ++e)
+                {
+                    const int f = (e + 1) % 3;
+                    if (robust_orient2d<predicate_type, Statistics>(vx[e], vy[e], vx[f], vy[f], x, y) < 0)
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            };
+
+            Real low = (std::numeric_limits<Real>::max)();
+            Real high = std::numeric_limits<Real>::lowest();
+            for (int e = 0; e < 3; ++e)
+            {
+                const int f = (e + 1) % 3;
+                if ((vy[e] <= y && y <= vy[f]) || (vy[f] <= y && y <= vy[e]))
+                {
+                    const Real xs[2] = {vy[e] == vy[f] ? vx[e] : vx[e] + (y - vy[e]) * (vx[f] - vx[e]) / (vy[f] - vy[e]), vx[f]};
+                    for (int k = 0; k < (vy[e] == vy[f] ? 2 : 1); ++k)
+                    {
+                        const Real s = (xs[k] - grid.x0) / grid.dx;
+                        low = (std::min)(low, s);
+                        high = (std::max)(high, s);
+                    }
+                }
+            }
+            if (low > high)
+            {
+                continue;
+            }
+
+            auto first = static_cast<std::ptrdiff_t>(first_column);
+            auto last = static_cast<std::ptrdiff_t>(last_column);
+            if (floor(low) > static_cast<Real>(first))
+            {
+                first = static_cast<std::ptrdiff_t>(floor(low));
+            }
+            if (ceil(high) < static_cast<Real>(last))
+            {
+                last = static_cast<std::ptrdiff_t>(ceil(high));
+            }
+            while (first <= last && !inside(first))
+            {
+                ++first;
+            }
+            while (last >= first && !inside(last))
+            {
+                --last;
+            }
+            if (first <= last)
+            {
+                patch.evaluate_row(grid.x0, grid.dx, first, last + 1, y, out + static_cast<std::ptrdiff_t>(j) * grid.row_stride, grid.column_stride);
+            }
+        }
+    }
+
+    // The quintics of the channels on triangle t; ghost triangles get NaN coefficients
+    void fit_patches (index_type t)
+    {
+        akima_patch<Real>* patch = &patches_[channels_ * t];
+        if (triangulation_.is_ghost(t))
+        {
+            for (std::size_t c = 0; c < channels_; ++c)
+            {
+                patch[c].x0 = patch[c].y0 = patch[c].ap = patch[c].bp = patch[c].cp = patch[c].dp = std::numeric_limits<Real>::quiet_NaN();
+                std::fill(patch[c].p, patch[c].p + 21, std::numeric_limits<Real>::quiet_NaN());
+            }
+            return;
+        }
+
+        fit_type x[3];
+        fit_type y[3];
+        index_type v[3];
+        for (int i = 0; i < 3; ++i)
+        {
+            v[i] = triangulation_.vertex(t, i);
+            x[i] = triangulation_.x(v[i]);
+            y[i] = triangulation_.y(v[i]);
+        }
+        for (std::size_t c = 0; c < channels_; ++c)
+        {
+            fit_type z[3];
+            const fit_type* d[3];
+            for (int i = 0; i < 3; ++i)
+            {
+                z[i] = z_[channels_ * v[i] + c];
+                d[i] = &derivatives_[5 * (channels_ * v[i] + c)];
+            }
+            fit_akima_patch(patch[c], x, y, z, d);
+        }
+    }
+
+    // The nearest_ nodes closest to v, nearest first. The k-th nearest node is a Delaunay neighbor of v
+    // or of one of the k - 1 nearer ones, so a best-first search along the arcs finds them.
+    void nearest_nodes (index_type v, derivative_scratch& s, const adjacency* arcs) const
+    {
+        const fit_type px = triangulation_.x(v);
+        const fit_type py = triangulation_.y(v);
+        auto distance = [&](index_type u)
+        {
+            const fit_type dx = triangulation_.x(u) - px;
+            const fit_type dy = triangulation_.y(u) - py;
+            return dx * dx + dy * dy;
+        };
+        auto expand = [&](index_type u)
+        {
+            const index_type* first = nullptr;
+            const index_type* last = nullptr;
+            if (arcs == nullptr)
+            {
+                s.ring.clear();
+                triangulation_.neighbors(u, std::back_inserter(s.ring));
+                first = s.ring.data();
+                last = first + s.ring.size();
+            }
+            else
+            {
+                first = arcs->nodes.data() + arcs->offsets[u];
+                last = arcs->nodes.data() + arcs->offsets[u + 1];
+            }
+            for (; first != last; ++first)
+            {
+                const index_type w = *first;
+                if (s.see(w))
+                {
+                    s.heap.emplace_back(distance(w), w);
+                    std::push_heap(s.heap.begin(), s.heap.end(), std::greater<std::pair<fit_type, index_type>>());
+                }
+            }
+        };
+
+        s.clear_seen(8 * (nearest_ + 1));
+        s.heap.clear();
+        s.nodes.clear();
+        s.see(v);
+        expand(v);
+        while (s.nodes.size() < nearest_ && !s.heap.empty())
+        {
+            std::pop_heap(s.heap.begin(), s.heap.end(), std::greater<std::pair<fit_type, index_type>>());
+            const index_type u = s.heap.back().second;
+            s.heap.pop_back();
+            s.nodes.push_back(u);
+            expand(u);
+        }
+    }
+
+    // The nearest nodes of v, kept in its neighborhood, and the squared radius of the disk holding them
+    void find_neighborhood (index_type v, derivative_scratch& s, const adjacency* arcs)
+    {
+        nearest_nodes(v, s, arcs);
+        std::copy(s.nodes.begin(), s.nodes.end(), neighborhoods_.begin() + static_cast<std::ptrdiff_t>(nearest_ * v));
+        const fit_type dx = static_cast<fit_type>(triangulation_.x(s.nodes.back())) - triangulation_.x(v);
+        const fit_type dy = static_cast<fit_type>(triangulation_.y(s.nodes.back())) - triangulation_.y(v);
+        radius_[v] = dx * dx + dy * dy;
+    }
+
+    void estimate_derivatives (index_type v, derivative_scratch& s)
+    {
+        estimate_akima_derivatives(v, &neighborhoods_[nearest_ * v], static_cast<index_type>(nearest_), radius_[v], channels_,
+                                   [this](index_type u) { return static_cast<fit_type>(triangulation_.x(u)); },
+                                   [this](index_type u) { return static_cast<fit_type>(triangulation_.y(u)); },
+                                   [this](index_type u, std::size_t c) { return static_cast<fit_type>(z_[channels_ * u + c]); },
+                                   s, &derivatives_[5 * channels_ * v]);
+    }
+
+    // The values at the nodes, whose coordinates the triangulation holds
+    values_type z_;
+    triangulation_type triangulation_;
+    std::size_t channels_;
+
+    // The seconds of the phases of fitting, under collect_statistics
+    bivariate_akima_statistics phases_;
+    location_grid<Real, Index> grid_;
+    double cells_per_node_ = 0;
+
+    // Names the triangles and the location index for the hints of the threads
+    std::uint64_t generation_ = next_generation();
+    std::size_t changes_ = 0;
+    std::size_t requested_nearest_;
+    std::size_t nearest_;
+
+    // The nearest_ nearest nodes of each node, nearest first, kept so that new values are fitted without
+    // searching again
+    std::vector<index_type> neighborhoods_;
+
+    // The squared distance from each node to the farthest of its nearest nodes
+    std::vector<fit_type> radius_;
+
+    // z_x, z_y, z_xx, z_xy, z_yy of each channel at each node
+    std::vector<fit_type> derivatives_;
+
+    // The quintics of the channels on each triangle, adjacent so that one location serves them all, and
+    // fitted once so that a query costs a lookup and a Horner evaluation
+    std::vector<akima_patch<Real>, boost::alignment::aligned_allocator<akima_patch<Real>, 64>> patches_;
+};
+
+}}}} // Namespaces
+
+#endif // BOOST_MATH_INTERPOLATORS_DETAIL_BIVARIATE_AKIMA_DETAIL_HPP
@@ -0,0 +1,17 @@
+//  (C) Copyright Matt Borland 2022.
+//  Use, modification and distribution are subject to the
+//  Boost Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_MATH_INTERPOLATORS_DETAIL_GPU_HPP
+#define BOOST_MATH_INTERPOLATORS_DETAIL_GPU_HPP
+
+// Marks the functions that the evaluation kernels of detail/akima_tables.hpp call on a device as well as
+// on the host. CUDA and HIP need the annotation; SYCL compiles any function reachable from a kernel.
+#if defined(__CUDACC__) || defined(__HIPCC__)
+#define BOOST_MATH_INTERPOLATORS_GPU_ENABLED __host__ __device__
+#else
+#define BOOST_MATH_INTERPOLATORS_GPU_ENABLED
+#endif
+
+#endif // BOOST_MATH_INTERPOLATORS_DETAIL_GPU_HPP
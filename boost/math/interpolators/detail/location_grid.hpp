@@ -0,0 +1,200 @@
+//  (C) Copyright Matt Borland 2022.
+//  Use, modification and distribution are subject to the
+//  Boost Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_MATH_INTERPOLATORS_DETAIL_LOCATION_GRID_HPP
+#define BOOST_MATH_INTERPOLATORS_DETAIL_LOCATION_GRID_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include <boost/math/interpolators/detail/gpu.hpp>
+#include <boost/math/interpolators/detail/triangulation.hpp>
+
+namespace boost { namespace math { namespace interpolators { namespace detail {
+
+// The cells of a location grid: columns by rows cells over the box from (x_min, y_min), of width
+// 1 / x_scale and height 1 / y_scale, numbered row by row. Points outside of the box use the nearest cell.
+template <typename Real>
+struct grid_frame
+{
+    Real x_min = 0;
+    Real y_min = 0;
+    Real x_scale = 0;
+    Real y_scale = 0;
+    std::uint64_t columns = 0;
+    std::uint64_t rows = 0;
+
+    BOOST_MATH_INTERPOLATORS_GPU_ENABLED std::size_t cell (Real x, Real y) const
+    {
+        return clamp((y - y_min) * y_scale, rows) * columns + clamp((x - x_min) * x_scale, columns);
+    }
+
+private:
+    BOOST_MATH_INTERPOLATORS_GPU_ENABLED static std::size_t clamp (Real c, std::uint64_t n)
+    {
+        return !(c > 0) ? 0 : c >= static_cast<Real>(n) ? static_cast<std::size_t>(n - 1) : static_cast<std::size_t>(c);
+    }
+};
+
+// Point location index over a triangulation: a uniform grid over the bounding box of the nodes whose
+// cells store a triangle near their centers, from which walks to the points of the cell are short
+// wherever the cells are no coarser than the triangles. The cells have about the aspect ratio of the
+// box, and their number, cells_per_node times the number of nodes, trades memory for shorter walks.
+// The grid refers to the triangulation by index and must be rebuilt when it changes.
+template <typename Real, typename Index = std::uint32_t>
+class location_grid
+{
+public:
+    using index_type = typename triangulation<Real, Index>::index_type;
+
+    location_grid () = default;
+
+    template <typename Allocator, typename Statistics>
+    location_grid (const triangulation<Real, Index, Allocator, Statistics>& tri, double cells_per_node = 1)
+    {
+        using std::sqrt;
+
+        if (!(cells_per_node > 0))
+        {
+            std::ostringstream oss;
+            oss << "The number of cells per node must be positive, but is " << cells_per_node << ".";
+            throw std::domain_error(oss.str());
+        }
+
+        Real x_min = tri.x(0);
+        Real y_min = tri.y(0);
+        Real x_max = x_min;
+        Real y_max = y_min;
+        for (index_type v = 1; v < tri.size(); ++v)
+        {
+            x_min = (std::min)(x_min, tri.x(v));
+            x_max = (std::max)(x_max, tri.x(v));
+            y_min = (std::min)(y_min, tri.y(v));
+            y_max = (std::max)(y_max, tri.y(v));
+        }
+
+        const double cells = (std::max)(1.0, cells_per_node * static_cast<double>(tri.size()));
+        const double width = static_cast<double>(x_max - x_min);
+        const double height = static_cast<double>(y_max - y_min);
+        const double square_columns = height > 0 ? sqrt(cells * width / height) : cells;
+        const auto columns = static_cast<std::size_t>((std::min)((std::max)(square_columns, 1.0), cells));
+        const auto rows = (std::max)(static_cast<std::size_t>(cells / static_cast<double>(columns)), static_cast<std::size_t>(1));
+        frame_.x_min = x_min;
+        frame_.y_min = y_min;
+        frame_.x_scale = x_max > x_min ? static_cast<Real>(columns) / (x_max - x_min) : Real(0);
+        frame_.y_scale = y_max > y_min ? static_cast<Real>(rows) / (y_max - y_min) : Real(0);
+        frame_.columns = columns;
+        frame_.rows = rows;
+
+        // The centers are located row by row in alternating directions, each walk starting from the
+        // triangle of the previous center
+        seeds_.resize(columns * rows);
+        index_type t = triangulation<Real, Index, Allocator, Statistics>::npos;
+        for (std::size_t r = 0; r < rows; ++r)
+        {
+            const Real y = y_min + (static_cast<Real>(r) + Real(0.5)) * (y_max - y_min) / static_cast<Real>(rows);
+            for (std::size_t k = 0; k < columns; ++k)
+            {
+                const std::size_t c = r % 2 == 0 ? k : columns - 1 - k;
+                const Real x = x_min + (static_cast<Real>(c) + Real(0.5)) * (x_max - x_min) / static_cast<Real>(columns);
+                t = tri.locate(x, y, t);
+                seeds_[r * columns + c] = t;
+            }
+        }
+    }
+
+    bool empty () const
+    {
+        return seeds_.empty();
+    }
+
+    // A triangle from which to walk to (x, y); points outside of the box use the nearest cell
+    index_type seed (Real x, Real y) const
+    {
+        return seeds_[cell(x, y)];
+    }
+
+    std::size_t cell (Real x, Real y) const
+    {
+        return frame_.cell(x, y);
+    }
+
+    std::size_t columns () const
+    {
+        return static_cast<std::size_t>(frame_.columns);
+    }
+
+    std::size_t rows () const
+    {
+        return static_cast<std::size_t>(frame_.rows);
+    }
+
+    const grid_frame<Real>& frame () const
+    {
+        return frame_;
+    }
+
+    // The triangle of each cell
+    const index_type* seeds () const
+    {
+        return seeds_.data();
+    }
+
+    std::size_t bytes () const
+    {
+        return sizeof(index_type) * seeds_.capacity() + sizeof(*this);
+    }
+
+private:
+    grid_frame<Real> frame_;
+    std::vector<index_type> seeds_;
+};
+
+// A number never given out twice in the process, which names a state of an interpolator: unlike its
+// address, it is not reused by a later interpolator, and it is renewed when the triangles change
+inline std::uint64_t next_generation ()
+{
+    static std::atomic<std::uint64_t> counter {0};
+    return ++counter;
+}
+
+// The hint of the calling thread for the interpolator of the given generation. The thread keeps the
+// hints of the last few interpolators it queried, so that alternating between them keeps the locality
+// of each, and starts afresh for one it has not queried since it changed.
+template <typename Hint>
+Hint& thread_hint (std::uint64_t generation)
+{
+    struct slot
+    {
+        std::uint64_t generation;
+        Hint hint;
+    };
+    constexpr std::size_t slots = 4;
+    thread_local slot cache[slots] = {};
+    thread_local std::size_t next = 0;
+    for (slot& s : cache)
+    {
+        if (s.generation == generation)
+        {
+            return s.hint;
+        }
+    }
+
+    slot& s = cache[next];
+    next = (next + 1) % slots;
+    s.generation = generation;
+    s.hint = Hint();
+    return s.hint;
+}
+
+}}}} // Namespaces
+
+#endif // BOOST_MATH_INTERPOLATORS_DETAIL_LOCATION_GRID_HPP
@@ -0,0 +1,320 @@
+//  (C) Copyright Matt Borland 2022.
+//  Use, modification and distribution are subject to the
+//  Boost Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_MATH_INTERPOLATORS_DETAIL_STATISTICS_HPP
+#define BOOST_MATH_INTERPOLATORS_DETAIL_STATISTICS_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace boost { namespace math { namespace interpolators {
+
+// Statistics policies of the triangulation and the interpolators. With no_statistics, the default, the
+// hooks are empty and compile to nothing; with collect_statistics the objects count the work of their
+// hot paths and time the phases of their construction, readable through statistics().
+struct no_statistics {};
+struct collect_statistics {};
+
+// The work of a triangulation since its construction or the last reset_statistics
+struct triangulation_statistics
+{
+    // Point locations (TRFIND), by insertions and by queries, and the triangles that their walks crossed
+    std::uint64_t locations = 0;
+    std::uint64_t walk_steps = 0;
+    std::uint64_t longest_walk = 0;
+
+    // Walks defeated by rounding, which fell back to testing every triangle
+    std::uint64_t exhaustive_searches = 0;
+
+    // Nodes inserted, and arcs swapped by the insertions, the removals and the constraints
+    std::uint64_t insertions = 0;
+    std::uint64_t flips = 0;
+
+    // Predicates too close to zero for their floating point filter, evaluated in exact arithmetic
+    std::uint64_t orient2d_fallbacks = 0;
+    std::uint64_t incircle_fallbacks = 0;
+
+    // Wall clock seconds of the phases of construction on the calling thread: the ordering of the nodes,
+    // their insertion, the cells and seams of a partitioned construction, and the constraint curves
+    double ordering_seconds = 0;
+    double insertion_seconds = 0;
+    double cell_seconds = 0;
+    double stitching_seconds = 0;
+    double constraint_seconds = 0;
+
+    double mean_walk () const
+    {
+        return locations > 0 ? static_cast<double>(walk_steps) / static_cast<double>(locations) : 0;
+    }
+
+    double flips_per_insertion () const
+    {
+        return insertions > 0 ? static_cast<double>(flips) / static_cast<double>(insertions) : 0;
+    }
+};
+
+// The work of an interpolator: that of its triangulation, which includes the locations of the queries,
+// and the seconds spent finding the nearest nodes, estimating the derivatives and fitting the quintics
+struct bivariate_akima_statistics
+{
+    triangulation_statistics triangulation;
+    double neighborhood_seconds = 0;
+    double derivative_seconds = 0;
+    double patch_seconds = 0;
+};
+
+namespace detail {
+
+// The exact evaluations of the predicates on the calling thread, which the recorders read before and
+// after an operation
+struct exact_predicate_counts
+{
+    std::uint64_t orient2d = 0;
+    std::uint64_t incircle = 0;
+};
+
+inline exact_predicate_counts& exact_predicate_counters ()
+{
+    thread_local exact_predicate_counts counts;
+    return counts;
+}
+
+// Counts an exact evaluation of a predicate, for collect_statistics only, so that the predicates of the
+// no_statistics objects touch no thread_local
+template <typename Statistics>
+inline void count_exact_predicate (std::uint64_t exact_predicate_counts::*) {}
+
+template <>
+inline void count_exact_predicate<collect_statistics> (std::uint64_t exact_predicate_counts::* predicate)
+{
+    ++(exact_predicate_counters().*predicate);
+}
+
+// Measures the seconds of a phase into a counter, for collect_statistics only
+template <typename Statistics>
+class phase_timer
+{
+public:
+    explicit phase_timer (double&) {}
+
+    void stop () {}
+};
+
+template <>
+class phase_timer<collect_statistics>
+{
+public:
+    explicit phase_timer (double& seconds)
+        : seconds_ {seconds}, start_ {std::chrono::steady_clock::now()}
+    {}
+
+    phase_timer (const phase_timer&) = delete;
+    phase_timer& operator= (const phase_timer&) = delete;
+
+    ~phase_timer ()
+    {
+        stop();
+    }
+
+    // Ends the phase before the end of the scope
+    void stop ()
+    {
+        if (running_)
+        {
+            running_ = false;
+            seconds_ += std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+        }
+    }
+
+private:
+    double& seconds_;
+    std::chrono::steady_clock::time_point start_;
+    bool running_ = true;
+};
+
+// The counters of a triangulation. The no_statistics recorder is empty and its hooks do nothing.
+template <typename Statistics>
+class statistics_recorder
+{
+public:
+    // Counts the exact predicates of the calling thread during its lifetime
+    class scope
+    {
+    public:
+        explicit scope (const statistics_recorder&) {}
+    };
+
+    void location (std::uint64_t, bool) const {}
+    void insertion () const {}
+    void flip () const {}
+    void merge (const triangulation_statistics&) const {}
+
+    // For phase_timer, which ignores it under this policy
+    double& seconds (double triangulation_statistics::*)
+    {
+        static double ignored = 0;
+        return ignored;
+    }
+
+    triangulation_statistics snapshot () const
+    {
+        return triangulation_statistics();
+    }
+
+    void reset () {}
+};
+
+// The counters are atomic, with relaxed ordering, so that concurrent queries of a const triangulation,
+// and the cells of a partitioned construction, can record their work; they then contend for the cache
+// lines of the counters.
+template <>
+class statistics_recorder<collect_statistics>
+{
+public:
+    class scope
+    {
+    public:
+        explicit scope (const statistics_recorder& recorder)
+            : recorder_ {recorder}, start_ {exact_predicate_counters()}
+        {}
+
+        scope (const scope&) = delete;
+        scope& operator= (const scope&) = delete;
+
+        ~scope ()
+        {
+            const exact_predicate_counts& now = exact_predicate_counters();
+            recorder_.orient2d_fallbacks_.fetch_add(now.orient2d - start_.orient2d, std::memory_order_relaxed);
+            recorder_.incircle_fallbacks_.fetch_add(now.incircle - start_.incircle, std::memory_order_relaxed);
+        }
+
+    private:
+        const statistics_recorder& recorder_;
+        exact_predicate_counts start_;
+    };
+
+    statistics_recorder () = default;
+
+    statistics_recorder (const statistics_recorder& other)
+    {
+        store(other.snapshot());
+    }
+
+    statistics_recorder& operator= (const statistics_recorder& other)
+    {
+        store(other.snapshot());
+        return *this;
+    }
+
+    void location (std::uint64_t steps, bool exhaustive) const
+    {
+        locations_.fetch_add(1, std::memory_order_relaxed);
+        walk_steps_.fetch_add(steps, std::memory_order_relaxed);
+        raise_longest_walk(steps);
+        if (exhaustive)
+        {
+            exhaustive_searches_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void insertion () const
+    {
+        insertions_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void flip () const
+    {
+        flips_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Adds the counters, but not the seconds, of another triangulation built for this one by the calling
+    // thread, whose exact predicates are taken off the thread so that its enclosing scope, if any, does
+    // not count them twice
+    void merge (const triangulation_statistics& other) const
+    {
+        exact_predicate_counts& thread = exact_predicate_counters();
+        thread.orient2d -= other.orient2d_fallbacks;
+        thread.incircle -= other.incircle_fallbacks;
+        locations_.fetch_add(other.locations, std::memory_order_relaxed);
+        walk_steps_.fetch_add(other.walk_steps, std::memory_order_relaxed);
+        raise_longest_walk(other.longest_walk);
+        exhaustive_searches_.fetch_add(other.exhaustive_searches, std::memory_order_relaxed);
+        insertions_.fetch_add(other.insertions, std::memory_order_relaxed);
+        flips_.fetch_add(other.flips, std::memory_order_relaxed);
+        orient2d_fallbacks_.fetch_add(other.orient2d_fallbacks, std::memory_order_relaxed);
+        incircle_fallbacks_.fetch_add(other.incircle_fallbacks, std::memory_order_relaxed);
+    }
+
+    // The phases are timed by the non-const, single threaded operations only
+    double& seconds (double triangulation_statistics::* phase)
+    {
+        return seconds_.*phase;
+    }
+
+    triangulation_statistics snapshot () const
+    {
+        triangulation_statistics s = seconds_;
+        s.locations = locations_.load(std::memory_order_relaxed);
+        s.walk_steps = walk_steps_.load(std::memory_order_relaxed);
+        s.longest_walk = longest_walk_.load(std::memory_order_relaxed);
+        s.exhaustive_searches = exhaustive_searches_.load(std::memory_order_relaxed);
+        s.insertions = insertions_.load(std::memory_order_relaxed);
+        s.flips = flips_.load(std::memory_order_relaxed);
+        s.orient2d_fallbacks = orient2d_fallbacks_.load(std::memory_order_relaxed);
+        s.incircle_fallbacks = incircle_fallbacks_.load(std::memory_order_relaxed);
+        return s;
+    }
+
+    void reset ()
+    {
+        store(triangulation_statistics());
+    }
+
+private:
+    void raise_longest_walk (std::uint64_t steps) const
+    {
+        std::uint64_t longest = longest_walk_.load(std::memory_order_relaxed);
+        while (steps > longest && !longest_walk_.compare_exchange_weak(longest, steps, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    void store (const triangulation_statistics& s)
+    {
+        seconds_ = triangulation_statistics();
+        seconds_.ordering_seconds = s.ordering_seconds;
+        seconds_.insertion_seconds = s.insertion_seconds;
+        seconds_.cell_seconds = s.cell_seconds;
+        seconds_.stitching_seconds = s.stitching_seconds;
+        seconds_.constraint_seconds = s.constraint_seconds;
+        locations_.store(s.locations, std::memory_order_relaxed);
+        walk_steps_.store(s.walk_steps, std::memory_order_relaxed);
+        longest_walk_.store(s.longest_walk, std::memory_order_relaxed);
+        exhaustive_searches_.store(s.exhaustive_searches, std::memory_order_relaxed);
+        insertions_.store(s.insertions, std::memory_order_relaxed);
+        flips_.store(s.flips, std::memory_order_relaxed);
+        orient2d_fallbacks_.store(s.orient2d_fallbacks, std::memory_order_relaxed);
+        incircle_fallbacks_.store(s.incircle_fallbacks, std::memory_order_relaxed);
+    }
+
+    mutable std::atomic<std::uint64_t> locations_ {0};
+    mutable std::atomic<std::uint64_t> walk_steps_ {0};
+    mutable std::atomic<std::uint64_t> longest_walk_ {0};
+    mutable std::atomic<std::uint64_t> exhaustive_searches_ {0};
+    mutable std::atomic<std::uint64_t> insertions_ {0};
+    mutable std::atomic<std::uint64_t> flips_ {0};
+    mutable std::atomic<std::uint64_t> orient2d_fallbacks_ {0};
+    mutable std::atomic<std::uint64_t> incircle_fallbacks_ {0};
+
+    // Only the seconds are used
+    triangulation_statistics seconds_;
+};
+
+} // namespace detail
+
+}}} // Namespaces
+
+#endif // BOOST_MATH_INTERPOLATORS_DETAIL_STATISTICS_HPP
@@ -0,0 +1,551 @@
+//  (C) Copyright Matt Borland 2022.
+//  Use, modification and distribution are subject to the
+//  Boost Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+//  Isenburg, M., Liu, Y., Shewchuk, J. & Snoeyink, J. (2006). Streaming computation of Delaunay
+//  triangulations. ACM Transactions on Graphics 25, 1049-1056.
+
+#ifndef BOOST_MATH_INTERPOLATORS_DETAIL_STREAMING_TRIANGULATION_HPP
+#define BOOST_MATH_INTERPOLATORS_DETAIL_STREAMING_TRIANGULATION_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include <boost/math/interpolators/detail/triangulation.hpp>
+
+namespace boost { namespace math { namespace interpolators { namespace detail {
+
+// Delaunay triangulation of a stream of points too large to hold at once, as in Isenburg et al., with a
+// sweep line for finalization: the points arrive in chunks sorted by abscissa, and each chunk declares a
+// front, below which no later point falls. A triangle whose circumdisk lies behind the front can no
+// longer change, so it is emitted, and a node all of whose triangles have been emitted is retired, so
+// that the nodes held are those of a strip along the front, however long the stream.
+//
+// The nodes held are triangulated by a triangulation, to which each chunk is added by ADDNOD with the
+// same predicates as the constructor. A node is retired by DELNOD, which refills its star with triangles
+// of the nodes held that are not Delaunay triangles of the stream; they lie behind the front, so no
+// later point disturbs them, and they are recorded so as not to be emitted. The triangles emitted, over
+// the whole stream, are exactly the triangles of the Delaunay triangulation of all of its points, each
+// once, up to the choice of triangles where four or more points are cocircular.
+//
+// The points are numbered in the order of the stream, from 0, and the triangles are emitted as three
+// such numbers, counterclockwise. All points must lie in the box given to the constructor: a triangle
+// on the convex hull of the points held is emitted once no later point of the box can see its boundary
+// edge. Each chunk costs time in proportion to the nodes held, so the chunks should be no smaller than
+// the strip. The object cannot be used after an exception.
+//
+// Constraint curves are forced into the nodes held by ADDCST, as add_constraints of the triangulation,
+// which finds their orientations from polygonal_area_sum, and the triangles emitted are then those of
+// the constrained Delaunay triangulation. A curve is given by the numbers of its points in the stream,
+// all of which must still be held, and must not cross a triangle already emitted: it is given with the
+// chunk of its last point, so that it is forced before that chunk finalizes any triangle, and its arcs
+// lie ahead of the previous front. The nodes of the curves are never retired. Triangles inside of holes
+// are emitted as well, as the triangulation keeps them.
+//
+// streaming_bivariate_akima drives the same steps, emitting triangles only once their quintics can be
+// fitted and retiring only the nodes that no estimate still needs.
+template <typename Real, typename Index = std::uint32_t>
+class streaming_triangulation
+{
+public:
+    using triangulation_type = triangulation<Real, Index>;
+    using index_type = Index;
+    using predicate_type = typename triangulation_type::predicate_type;
+
+    static constexpr index_type npos = triangulation_type::npos;
+
+    streaming_triangulation (Real x_min, Real x_max, Real y_min, Real y_max)
+        : x_min_ {x_min}, x_max_ {x_max}, y_min_ {y_min}, y_max_ {y_max}, front_ {std::numeric_limits<Real>::lowest()}
+    {
+        using std::isfinite;
+
+        if (!(isfinite(x_min) && isfinite(x_max) && isfinite(y_min) && isfinite(y_max) && x_min <= x_max && y_min <= y_max))
+        {
+            std::ostringstream oss;
+            oss << "The box [" << x_min << ", " << x_max << "] x [" << y_min << ", " << y_max << "] of the points is not a finite box.";
+            throw std::domain_error(oss.str());
+        }
+    }
+
+    // Adds the chunk of points (x[k], y[k]) and writes each triangle that it finalizes, as sink(a, b, c).
+    // The abscissas of the chunk must be at least the front of the previous chunk, and those of the later
+    // chunks at least front.
+    template <typename RAIter, typename Sink>
+    void push (RAIter x_begin, RAIter x_end, RAIter y_begin, RAIter y_end, Real front, Sink&& sink)
+    {
+        insert(x_begin, x_end, y_begin, y_end, [](std::size_t) {});
+        advance(front);
+        emit([](index_type) { return true; }, [this, &sink](index_type t) { write(t, sink); });
+        retire([](index_type) { return false; }, [](index_type, index_type) {});
+    }
+
+    template <typename RAContainer, typename Sink>
+    void push (const RAContainer& x, const RAContainer& y, Real front, Sink&& sink)
+    {
+        push(std::cbegin(x), std::cend(x), std::cbegin(y), std::cend(y), front, sink);
+    }
+
+    // push, forcing the constraint curves, containers of numbers in the stream, after the points of the
+    // chunk are added
+    template <typename RAContainer, typename Curves, typename Sink>
+    void push (const RAContainer& x, const RAContainer& y, const Curves& curves, Real front, Sink&& sink)
+    {
+        insert(std::cbegin(x), std::cend(x), std::cbegin(y), std::cend(y), [](std::size_t) {});
+        add_constraints(curves);
+        advance(front);
+        emit([](index_type) { return true; }, [this, &sink](index_type t) { write(t, sink); });
+        retire([](index_type) { return false; }, [](index_type, index_type) {});
+    }
+
+    // Ends the stream and writes the remaining triangles
+    template <typename Sink>
+    void finish (Sink&& sink)
+    {
+        close();
+        emit([](index_type) { return true; }, [this, &sink](index_type t) { write(t, sink); });
+    }
+
+    // The steps of push, for streaming_bivariate_akima: added(k) is called once point k of the chunk has
+    // become the last node held
+    template <typename RAIter, typename Added>
+    void insert (RAIter x_begin, RAIter x_end, RAIter y_begin, RAIter y_end, Added added)
+    {
+        const auto n = static_cast<std::size_t>(std::distance(x_begin, x_end));
+        if (n != static_cast<std::size_t>(std::distance(y_begin, y_end)))
+        {
+            throw std::domain_error("There must be the same number of abscissas and ordinates.");
+        }
+
+        std::vector<Real> xs(n);
+        std::vector<Real> ys(n);
+        for (std::size_t k = 0; k < n; ++k, ++x_begin, ++y_begin)
+        {
+            xs[k] = static_cast<Real>(*x_begin);
+            ys[k] = static_cast<Real>(*y_begin);
+            if (!(xs[k] >= front_ && xs[k] >= x_min_ && xs[k] <= x_max_ && ys[k] >= y_min_ && ys[k] <= y_max_))
+            {
+                std::ostringstream oss;
+                oss.precision(std::numeric_limits<Real>::digits10 + 3);
+                oss << "Point " << pushed_ + k << " at (" << xs[k] << ", " << ys[k] << ") lies behind the front " << front_
+                    << " or outside of the box [" << x_min_ << ", " << x_max_ << "] x [" << y_min_ << ", " << y_max_ << "].";
+                throw std::domain_error(oss.str());
+            }
+        }
+
+        if (!tri_)
+        {
+            for (std::size_t k = 0; k < n; ++k)
+            {
+                pending_x_.push_back(xs[k]);
+                pending_y_.push_back(ys[k]);
+                ids_.push_back(pushed_ + k);
+                added(k);
+            }
+            pushed_ += n;
+            if (spans_plane())
+            {
+                build();
+            }
+            return;
+        }
+
+        // In a biased randomized order, so that consecutive walks are short
+        std::vector<index_type> nodes(n);
+        for (std::size_t k = 0; k < n; ++k)
+        {
+            nodes[k] = static_cast<index_type>(k);
+        }
+        for (const index_type k : brio_order<Real, index_type>(xs, ys, nodes))
+        {
+            tri_->add_node(xs[k], ys[k]);
+            ids_.push_back(pushed_ + k);
+            added(k);
+        }
+        pushed_ += n;
+    }
+
+    // Forces the curves, each a container of the numbers in the stream of its points, into the nodes held
+    template <typename Curves>
+    void add_constraints (const Curves& curves)
+    {
+        if (std::begin(curves) == std::end(curves))
+        {
+            return;
+        }
+        if (!tri_)
+        {
+            throw std::domain_error("Constraint curves can only be added once three of the points are not collinear.");
+        }
+
+        std::unordered_map<std::uint64_t, index_type> nodes;
+        nodes.reserve(ids_.size());
+        for (index_type v = 0; v < tri_->size(); ++v)
+        {
+            nodes.emplace(ids_[v], v);
+        }
+        std::vector<std::vector<index_type>> local;
+        for (const auto& curve : curves)
+        {
+            local.emplace_back();
+            for (const auto id : curve)
+            {
+                const auto it = nodes.find(static_cast<std::uint64_t>(id));
+                if (it == nodes.end())
+                {
+                    std::ostringstream oss;
+                    oss << "Point " << id << " of a constraint curve " << (static_cast<std::uint64_t>(id) < pushed_ ? "has been retired." : "has not arrived.");
+                    throw std::domain_error(oss.str());
+                }
+                local.back().push_back(it->second);
+            }
+        }
+
+        tri_->add_constraints(local);
+        constrained_.resize(tri_->size());
+        for (const auto& curve : local)
+        {
+            for (const index_type v : curve)
+            {
+                constrained_[v] = 1;
+            }
+        }
+
+        // ADDCST changes only the triangles that the curves cross, which must not have been emitted
+        std::unordered_set<triangle_key, triangle_hash> present;
+        present.reserve(tri_->triangle_count());
+        for (index_type t = 0; t < tri_->triangle_count(); ++t)
+        {
+            if (!tri_->is_ghost(t))
+            {
+                present.insert(key(t));
+            }
+        }
+        for (const triangle_key& k : done_)
+        {
+            if (present.count(k) == 0)
+            {
+                std::ostringstream oss;
+                oss << "A constraint curve crosses the triangle of points " << k[0] << ", " << k[1] << " and " << k[2] << ", which has been emitted.";
+                throw std::domain_error(oss.str());
+            }
+        }
+    }
+
+    void advance (Real front)
+    {
+        if (!(front >= front_))
+        {
+            std::ostringstream oss;
+            oss << "The front cannot move back, from " << front_ << " to " << front << ".";
+            throw std::domain_error(oss.str());
+        }
+        front_ = front;
+    }
+
+    // Past the last point: every triangle is final
+    void close ()
+    {
+        if (!tri_)
+        {
+            build();
+        }
+        front_ = std::numeric_limits<Real>::infinity();
+    }
+
+    // Calls emit(t) on each triangle t not yet emitted that is final and for which ready(t)
+    template <typename Ready, typename Emit>
+    void emit (Ready ready, Emit emit)
+    {
+        if (!tri_)
+        {
+            return;
+        }
+
+        for (index_type t = 0; t < tri_->triangle_count(); ++t)
+        {
+            if (!tri_->is_ghost(t) && is_final(t) && ready(t) && done_.insert(key(t)).second)
+            {
+                emit(t);
+            }
+        }
+    }
+
+    // Retires the nodes all of whose triangles have been emitted or are final ghost triangles, unless
+    // keep(v) says otherwise. moved(v, last) is called before the last node takes the index v of a
+    // retired one.
+    template <typename Keep, typename Moved>
+    void retire (Keep keep, Moved moved)
+    {
+        if (!tri_)
+        {
+            return;
+        }
+
+        // Some triangle not yet emitted keeps three nodes that are not collinear
+        bool pending = false;
+        for (index_type t = 0; t < tri_->triangle_count() && !pending; ++t)
+        {
+            pending = !tri_->is_ghost(t) && done_.count(key(t)) == 0;
+        }
+        if (!pending)
+        {
+            return;
+        }
+
+        std::vector<index_type> star;
+        std::vector<index_type> ring;
+        std::vector<index_type> changed;
+        std::vector<triangle_key> kept;
+        for (index_type v = tri_->size(); v-- > 0;)
+        {
+            if (!(tri_->x(v) < front_) || tri_->size() <= 3 || (v < constrained_.size() && constrained_[v]) || keep(v))
+            {
+                continue;
+            }
+
+            star.clear();
+            tri_->incident_triangles(v, std::back_inserter(star));
+            const bool retirable = std::all_of(star.begin(), star.end(), [this](index_type t)
+            {
+                return tri_->is_ghost(t) ? is_final_ghost(t) : done_.count(key(t)) > 0;
+            });
+            if (!retirable)
+            {
+                continue;
+            }
+
+            // The triangles of the neighbors that DELNOD may move to another slot without changing them
+            ring.clear();
+            tri_->neighbors(v, std::back_inserter(ring));
+            kept.clear();
+            for (const index_type u : ring)
+            {
+                changed.clear();
+                tri_->incident_triangles(u, std::back_inserter(changed));
+                for (const index_type t : changed)
+                {
+                    if (!tri_->is_ghost(t) && on_ring(t, ring))
+                    {
+                        kept.push_back(key(t));
+                    }
+                }
+            }
+            for (const index_type t : star)
+            {
+                if (!tri_->is_ghost(t))
+                {
+                    done_.erase(key(t));
+                }
+            }
+
+            const index_type last = tri_->size() - 1;
+            moved(v, last);
+            changed.clear();
+            tri_->remove_node(v, std::back_inserter(changed));
+            ids_[v] = ids_[last];
+            ids_.pop_back();
+            if (last < constrained_.size())
+            {
+                constrained_[v] = constrained_[last];
+                constrained_.pop_back();
+            }
+            for (index_type& u : ring)
+            {
+                if (u == last)
+                {
+                    u = v;
+                }
+            }
+
+            // The new triangles of the star are not Delaunay triangles of the stream
+            for (const index_type t : changed)
+            {
+                if (!tri_->is_ghost(t) && on_ring(t, ring))
+                {
+                    const triangle_key k = key(t);
+                    if (std::find(kept.begin(), kept.end(), k) == kept.end())
+                    {
+                        done_.insert(k);
+                    }
+                }
+            }
+        }
+    }
+
+    // True until three points that are not collinear have arrived
+    bool empty () const
+    {
+        return !tri_;
+    }
+
+    const triangulation_type& get_triangulation () const
+    {
+        return *tri_;
+    }
+
+    // The number in the stream of node v of the triangulation
+    std::uint64_t node_id (index_type v) const
+    {
+        return ids_[v];
+    }
+
+    // The points received
+    std::uint64_t size () const
+    {
+        return pushed_;
+    }
+
+    // The nodes held
+    std::size_t active () const
+    {
+        return ids_.size();
+    }
+
+    Real front () const
+    {
+        return front_;
+    }
+
+    // True if the circumdisk of triangle t lies behind the front, allowing for rounding
+    bool is_final (index_type t) const
+    {
+        Real ux = 0;
+        Real uy = 0;
+        Real reach = 0;
+        return front_ == std::numeric_limits<Real>::infinity() ||
+               (bounding_circumdisk(tri_->x(tri_->vertex(t, 0)), tri_->y(tri_->vertex(t, 0)), tri_->x(tri_->vertex(t, 1)),
+                                    tri_->y(tri_->vertex(t, 1)), tri_->x(tri_->vertex(t, 2)), tri_->y(tri_->vertex(t, 2)), ux, uy, reach) &&
+                ux + reach < front_);
+    }
+
+    std::size_t bytes () const
+    {
+        return (tri_ ? tri_->bytes() : 0) + (pending_x_.capacity() + pending_y_.capacity()) * sizeof(Real) +
+               ids_.capacity() * sizeof(std::uint64_t) + constrained_.capacity() + done_.size() * (sizeof(triangle_key) + 2 * sizeof(void*)) +
+               done_.bucket_count() * sizeof(void*) + sizeof(*this);
+    }
+
+private:
+    // The numbers of the vertices of a triangle, in increasing order
+    using triangle_key = std::array<std::uint64_t, 3>;
+
+    struct triangle_hash
+    {
+        std::size_t operator() (const triangle_key& k) const
+        {
+            return static_cast<std::size_t>(mix_bits(k[0] ^ mix_bits(k[1] ^ mix_bits(k[2]))));
+        }
+    };
+
+    triangle_key key (index_type t) const
+    {
+        triangle_key k = {ids_[tri_->vertex(t, 0)], ids_[tri_->vertex(t, 1)], ids_[tri_->vertex(t, 2)]};
+        std::sort(k.begin(), k.end());
+        return k;
+    }
+
+    bool on_ring (index_type t, const std::vector<index_type>& ring) const
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            if (std::find(ring.begin(), ring.end(), tri_->vertex(t, i)) == ring.end())
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // True if no later point of the box lies strictly outside of the boundary edge of ghost triangle t:
+    // the corners of the part of the box ahead of the front lie on its inner side or on its line
+    bool is_final_ghost (index_type t) const
+    {
+        if (front_ > x_max_)
+        {
+            return true;
+        }
+        const index_type a = tri_->vertex(t, 1);
+        const index_type b = tri_->vertex(t, 0);
+        const Real corners[4][2] = {{front_, y_min_}, {x_max_, y_min_}, {x_max_, y_max_}, {front_, y_max_}};
+        for (const auto& c : corners)
+        {
+            if (robust_orient2d<predicate_type>(tri_->x(a), tri_->y(a), tri_->x(b), tri_->y(b), c[0], c[1]) < 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <typename Sink>
+    void write (index_type t, Sink& sink) const
+    {
+        sink(ids_[tri_->vertex(t, 0)], ids_[tri_->vertex(t, 1)], ids_[tri_->vertex(t, 2)]);
+    }
+
+    // True once the pending points include three that are not collinear
+    bool spans_plane () const
+    {
+        const std::size_t n = pending_x_.size();
+        std::size_t k1 = 1;
+        while (k1 < n && pending_x_[k1] == pending_x_[0] && pending_y_[k1] == pending_y_[0])
+        {
+            ++k1;
+        }
+        for (std::size_t k2 = k1 + 1; k2 < n; ++k2)
+        {
+            if (robust_orient2d<predicate_type>(pending_x_[0], pending_y_[0], pending_x_[k1], pending_y_[k1], pending_x_[k2], pending_y_[k2]) != 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void build ()
+    {
+        tri_ = std::make_unique<triangulation_type>(pending_x_, pending_y_);
+        std::vector<Real>().swap(pending_x_);
+        std::vector<Real>().swap(pending_y_);
+    }
+
+    Real x_min_;
+    Real x_max_;
+    Real y_min_;
+    Real y_max_;
+    Real front_;
+    std::uint64_t pushed_ = 0;
+
+    // The points that arrive before three of them span the plane
+    std::vector<Real> pending_x_;
+    std::vector<Real> pending_y_;
+
+    std::unique_ptr<triangulation_type> tri_;
+
+    // The number in the stream of each node held, and whether it is a node of a constraint curve, up to
+    // the last such node
+    std::vector<std::uint64_t> ids_;
+    std::vector<char> constrained_;
+
+    // The triangles held that have been emitted, or that DELNOD made and must never be
+    std::unordered_set<triangle_key, triangle_hash> done_;
+};
+
+template <typename Real, typename Index>
+constexpr typename streaming_triangulation<Real, Index>::index_type streaming_triangulation<Real, Index>::npos;
+
+}}}} // Namespaces
+
+#endif // BOOST_MATH_INTERPOLATORS_DETAIL_STREAMING_TRIANGULATION_HPP
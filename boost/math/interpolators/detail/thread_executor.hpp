@@ -0,0 +1,104 @@
+//  (C) Copyright Matt Borland 2022.
+//  Use, modification and distribution are subject to the
+//  Boost Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_MATH_INTERPOLATORS_DETAIL_THREAD_EXECUTOR_HPP
+#define BOOST_MATH_INTERPOLATORS_DETAIL_THREAD_EXECUTOR_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace boost { namespace math { namespace interpolators { namespace detail {
+
+// The executors accepted by the parallel algorithms are callables e(count, f) which call f(i) once
+// for each i in [0, count), in any order and on any threads, and return when all calls have returned.
+// The results of the algorithms do not depend on the executor, so any thread pool can be adapted.
+//
+// sequential_executor runs the tasks in order on the calling thread.
+struct sequential_executor
+{
+    template <typename F>
+    void operator() (std::size_t count, F&& f) const
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            f(i);
+        }
+    }
+};
+
+// thread_executor runs the tasks on a fixed number of threads. The tasks are claimed one at a time from
+// a shared counter, so a thread that finishes its task early takes the next remaining one instead of
+// idling while the others work through a static share. The first exception thrown by a task is rethrown
+// once all threads have stopped; the tasks not yet started are then skipped.
+class thread_executor
+{
+public:
+    explicit thread_executor (std::size_t threads = std::thread::hardware_concurrency())
+        : threads_ {threads > 0 ? threads : 1}
+    {}
+
+    template <typename F>
+    void operator() (std::size_t count, F&& f) const
+    {
+        std::atomic<std::size_t> next {0};
+        std::exception_ptr error;
+        std::mutex error_mutex;
+
+        auto work = [&]()
+        {
+            for (std::size_t i = next++; i < count; i = next++)
+            {
+                try
+                {
+                    f(i);
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(error_mutex);
+                    if (!error)
+                    {
+                        error = std::current_exception();
+                    }
+                    next = count;
+                }
+            }
+        };
+
+        const std::size_t n = (std::min)(threads_, count);
+        std::vector<std::thread> pool;
+        pool.reserve(n > 0 ? n - 1 : 0);
+        for (std::size_t k = 1; k < n; ++k)
+        {
+            pool.emplace_back(work);
+        }
+        work();
+        for (auto& thread : pool)
+        {
+            thread.join();
+        }
+
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+
+    std::size_t threads () const
+    {
+        return threads_;
+    }
+
+private:
+    std::size_t threads_;
+};
+
+}}}} // Namespaces
+
+#endif // BOOST_MATH_INTERPOLATORS_DETAIL_THREAD_EXECUTOR_HPP
@@ -10,49 +10,3129 @@
 #ifndef BOOST_MATH_INTERPOLATORS_DETAIL_TRIANGULATION_HPP
 #define BOOST_MATH_INTERPOLATORS_DETAIL_TRIANGULATION_HPP
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <iterator>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
 #include <type_traits>
+#include <utility>
+#include <vector>
 #include <boost/math/tools/promotion.hpp>
+#include <boost/math/interpolators/detail/statistics.hpp>
 
 namespace boost { namespace math { namespace interpolators {
 
+// Summation policies for polygonal_area.
+//
+// naive_summation accumulates the shoelace terms directly (in independent lanes for float/double data).
+// compensated_summation uses error-free transformations for every difference, sum and product, so the
+// result is as accurate as if it were computed in twice the working precision and then rounded
+// (Ogita, Rump & Oishi, Accurate sum and dot product, SIAM J. Sci. Comput. 26 (2005)).
+// pairwise_summation adds blocks of terms pairwise so the rounding error grows as O(log n) rather than O(n).
+struct naive_summation {};
+struct compensated_summation {};
+struct pairwise_summation {};
+
+// Selects the constructors that borrow the coordinates, and values, of the caller instead of copying them
+struct borrow_nodes_t
+{
+    explicit borrow_nodes_t () = default;
+};
+
+constexpr borrow_nodes_t borrow_nodes {};
+
+namespace detail {
+
+template <typename T>
+struct is_summation_policy : std::integral_constant<bool,
+    std::is_same<T, naive_summation>::value ||
+    std::is_same<T, compensated_summation>::value ||
+    std::is_same<T, pairwise_summation>::value> {};
+
+// Number of independent partial sums used by the contiguous kernels: two 512-bit registers,
+// or four 256-bit registers, worth of lanes, which hides the latency of the vector adds.
+template <typename Real>
+struct polygonal_area_lanes : std::integral_constant<std::size_t, 128 / sizeof(Real)> {};
+
+// Each compensated lane carries a sum and a correction, so half as many lanes fit in the registers
+template <typename Real>
+struct compensated_lanes : std::integral_constant<std::size_t, 64 / sizeof(Real)> {};
+
+template <typename RAIter, typename Real>
+struct is_contiguous_floating : std::integral_constant<bool,
+    std::is_pointer<RAIter>::value && std::is_floating_point<Real>::value &&
+    std::is_same<typename std::remove_cv<typename std::remove_pointer<RAIter>::type>::type, Real>::value> {};
+
+// A std::array read through its constexpr operator[], which unlike data() is usable in constant
+// expressions before C++17; the kernels index it exactly as they index a pointer
+template <typename T, std::size_t N>
+struct array_elements
+{
+    const std::array<T, N>* elements;
+
+    constexpr const T& operator[] (std::size_t i) const
+    {
+        return (*elements)[i];
+    }
+};
+
+template <typename T, std::size_t N>
+struct is_contiguous_floating<array_elements<T, N>, T> : std::is_floating_point<T> {};
+
+// Node accessors: an explicit node list, or the vertices taken in order
+template <typename RAIter2>
+struct node_list
+{
+    RAIter2 nodes;
+
+    constexpr auto operator[] (std::size_t i) const -> decltype(nodes[i])
+    {
+        return nodes[i];
+    }
+};
+
+struct identity_nodes
+{
+    constexpr std::size_t operator[] (std::size_t i) const
+    {
+        return i;
+    }
+};
+
+template <typename Real>
+constexpr Real sum_lanes (Real* acc, std::size_t lanes)
+{
+    while (lanes > 1)
+    {
+        lanes /= 2;
+        for (std::size_t j = 0; j < lanes; ++j)
+        {
+            acc[j] += acc[j + lanes];
+        }
+    }
+
+    return acc[0];
+}
+
+// Knuth's TwoSum: a + b == s + e exactly
+template <typename Real>
+constexpr Real two_sum_error (Real a, Real b, Real s)
+{
+    const Real bb = s - a;
+    return (a - (s - bb)) + (b - bb);
+}
+
+// The shoelace term of TRIPACK AREAP for the arc from node_1 to node_2
+template <typename Real, typename RAIter, typename Node>
+constexpr Real shoelace_term (RAIter x, RAIter y, Node node_1, Node node_2)
+{
+    return (static_cast<Real>(x[node_2]) - static_cast<Real>(x[node_1])) *
+           (static_cast<Real>(y[node_1]) + static_cast<Real>(y[node_2]));
+}
+
+// Sum of the shoelace terms for the arcs ending at nodes[first], ..., nodes[last - 1], first >= 1
+template <typename Real, typename RAIter, typename Nodes>
+constexpr Real shoelace_sum (RAIter x, RAIter y, const Nodes& nodes, std::size_t first, std::size_t last, const std::false_type&)
+{
+    Real area = 0;
+    for (std::size_t i = first; i < last; ++i)
+    {
+        area += shoelace_term<Real>(x, y, nodes[i - 1], nodes[i]);
+    }
+
+    return area;
+}
+
+// Contiguous float/double coordinates: the dependent accumulator is split into independent lanes
+// so that the loop is throughput rather than latency bound and the compiler can vectorize the gather.
+template <typename Real, typename RAIter, typename Nodes>
+constexpr Real shoelace_sum (RAIter x, RAIter y, const Nodes& nodes, std::size_t first, std::size_t last, const std::true_type&)
+{
+    constexpr std::size_t lanes = polygonal_area_lanes<Real>::value;
+
+    Real acc[lanes] = {};
+    std::size_t i = first;
+    for (; i + lanes <= last; i += lanes)
+    {
+        for (std::size_t j = 0; j < lanes; ++j)
+        {
+            const auto node_1 = nodes[i + j - 1];
+            const auto node_2 = nodes[i + j];
+            acc[j] += (x[node_2] - x[node_1]) * (y[node_1] + y[node_2]);
+        }
+    }
+
+    Real area = 0;
+    for (; i < last; ++i)
+    {
+        const auto node_1 = nodes[i - 1];
+        const auto node_2 = nodes[i];
+        area += (x[node_2] - x[node_1]) * (y[node_1] + y[node_2]);
+    }
+
+    return area + sum_lanes(acc, lanes);
+}
+
+// Shoelace sum over a single closed curve of n nodes (TRIPACK AREAP) without the final scaling
+template <typename Real, typename RAIter, typename Nodes>
+constexpr Real polygonal_area_sum (RAIter x, RAIter y, const Nodes& nodes, std::size_t n, const naive_summation&)
+{
+    if (n < 3)
+    {
+        return static_cast<Real>(0);
+    }
+
+    return shoelace_term<Real>(x, y, nodes[n - 1], nodes[0]) +
+           shoelace_sum<Real>(x, y, nodes, 1, n, is_contiguous_floating<RAIter, Real>());
+}
+
+template <typename Real, typename RAIter, typename Nodes>
+constexpr Real polygonal_area_sum (RAIter x, RAIter y, const Nodes& nodes, std::size_t n, const pairwise_summation&)
+{
+    constexpr std::size_t block_size = 256;
+
+    if (n < 3)
+    {
+        return static_cast<Real>(0);
+    }
+
+    // Blocks are summed directly and then combined like a binary counter,
+    // so at most one partial sum per level (64 levels) is live at any time.
+    Real partial[64] = {};
+    std::size_t level[64] = {};
+    std::size_t top = 0;
+
+    for (std::size_t first = 1; first < n; first += block_size)
+    {
+        const std::size_t last = first + block_size < n ? first + block_size : n;
+        Real block = shoelace_sum<Real>(x, y, nodes, first, last, is_contiguous_floating<RAIter, Real>());
+        std::size_t block_level = 0;
+        while (top > 0 && level[top - 1] == block_level)
+        {
+            --top;
+            block = partial[top] + block;
+            ++block_level;
+        }
+        partial[top] = block;
+        level[top] = block_level;
+        ++top;
+    }
+
+    Real area = 0;
+    while (top > 0)
+    {
+        --top;
+        area += partial[top];
+    }
+
+    return area + shoelace_term<Real>(x, y, nodes[n - 1], nodes[0]);
+}
+
+// Compensated shoelace term: the differences and sums are split with TwoSum, the product with an fma,
+// and every rounding error is folded into the correction term.
+template <typename Real>
+inline void compensated_term (Real x_1, Real y_1, Real x_2, Real y_2, Real& sum, Real& correction)
+{
+    using std::fma;
+
+    const Real dx = x_2 - x_1;
+    const Real dx_error = two_sum_error(x_2, -x_1, dx);
+    const Real sy = y_1 + y_2;
+    const Real sy_error = two_sum_error(y_1, y_2, sy);
+
+    const Real p = dx * sy;
+    const Real p_error = fma(dx, sy, -p);
+
+    const Real s = sum + p;
+    correction += two_sum_error(sum, p, s) + (p_error + (dx * sy_error + dx_error * sy));
+    sum = s;
+}
+
+template <typename Real, typename RAIter, typename Nodes>
+Real compensated_shoelace_sum (RAIter x, RAIter y, const Nodes& nodes, std::size_t n, const std::false_type&)
+{
+    Real sum = 0;
+    Real correction = 0;
+    auto node_2 = nodes[n - 1];
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const auto node_1 = node_2;
+        node_2 = nodes[i];
+        compensated_term(static_cast<Real>(x[node_1]), static_cast<Real>(y[node_1]),
+                         static_cast<Real>(x[node_2]), static_cast<Real>(y[node_2]), sum, correction);
+    }
+
+    return sum + correction;
+}
+
+template <typename Real, typename RAIter, typename Nodes>
+Real compensated_shoelace_sum (RAIter x, RAIter y, const Nodes& nodes, std::size_t n, const std::true_type&)
+{
+    constexpr std::size_t lanes = compensated_lanes<Real>::value;
+
+    Real sum[lanes] = {};
+    Real correction[lanes] = {};
+    std::size_t i = 1;
+    for (; i + lanes <= n; i += lanes)
+    {
+        for (std::size_t j = 0; j < lanes; ++j)
+        {
+            const auto node_1 = nodes[i + j - 1];
+            const auto node_2 = nodes[i + j];
+            compensated_term(x[node_1], y[node_1], x[node_2], y[node_2], sum[j], correction[j]);
+        }
+    }
+    for (; i < n; ++i)
+    {
+        compensated_term(x[nodes[i - 1]], y[nodes[i - 1]], x[nodes[i]], y[nodes[i]], sum[0], correction[0]);
+    }
+    compensated_term(x[nodes[n - 1]], y[nodes[n - 1]], x[nodes[0]], y[nodes[0]], sum[0], correction[0]);
+
+    // Cascade the lane sums, again keeping the rounding errors
+    Real total = sum[0];
+    Real total_correction = correction[0];
+    for (std::size_t j = 1; j < lanes; ++j)
+    {
+        const Real s = total + sum[j];
+        total_correction += two_sum_error(total, sum[j], s) + correction[j];
+        total = s;
+    }
+
+    return total + total_correction;
+}
+
+template <typename Real, typename RAIter, typename Nodes>
+Real polygonal_area_sum (RAIter x, RAIter y, const Nodes& nodes, std::size_t n, const compensated_summation&)
+{
+    if (n < 3)
+    {
+        return static_cast<Real>(0);
+    }
+
+    return compensated_shoelace_sum<Real>(x, y, nodes, n, is_contiguous_floating<RAIter, Real>());
+}
+
+template <typename Real, typename RAIter, typename RAIter2, typename Summation>
+inline Real polygonal_area_sum (RAIter x_begin, RAIter y_begin, RAIter2 nodes_begin, RAIter2 nodes_end, const Summation& summation)
+{
+    const auto n = static_cast<std::size_t>(std::distance(nodes_begin, nodes_end));
+
+    return polygonal_area_sum<Real>(x_begin, y_begin, node_list<RAIter2> {nodes_begin}, n, summation);
+}
+
+// Contiguous storage of a container or view, so that std::vector, std::array and spans reach the pointer kernels
+template <typename RAContainer>
+auto contiguous_begin (const RAContainer& c, int) -> decltype(c.data())
+{
+    return c.data();
+}
+
+template <typename RAContainer>
+auto contiguous_begin (const RAContainer& c, long) -> decltype(std::cbegin(c))
+{
+    return std::cbegin(c);
+}
+
+template <typename RAIter>
+void check_coordinates (RAIter x_begin, RAIter x_end, RAIter y_begin, RAIter y_end)
+{
+    if (std::distance(x_begin, x_end) != std::distance(y_begin, y_end))
+    {
+        throw std::domain_error("There must be the same number of abscissas and ordinates.");
+    }
+}
+
+template <typename RAIter>
+void check_offsets (RAIter offsets_begin, RAIter offsets_end, std::ptrdiff_t nodes)
+{
+    for (auto it = std::next(offsets_begin); it != offsets_end; ++it)
+    {
+        if (*it < *std::prev(it) || static_cast<std::ptrdiff_t>(*it) > nodes)
+        {
+            std::ostringstream oss;
+            oss << "The offsets of the curves must not decrease or pass the " << nodes << " nodes, but offset "
+                << std::distance(offsets_begin, it) << " is " << *it << " after " << *std::prev(it) << ".";
+            throw std::domain_error(oss.str());
+        }
+    }
+}
+
+} // namespace detail
+
 // Returns the signed area bounded by a polygonal curve, such as a constraint curve
+template <typename RAIter, typename RAIter2, typename Summation,
+          typename std::enable_if<detail::is_summation_policy<Summation>::value, bool>::type = true>
+auto polygonal_area (RAIter x_begin, RAIter x_end, RAIter y_begin, RAIter y_end, RAIter2 nodes_begin, RAIter2 nodes_end,
+                     const Summation& summation)
+{
+    using Real = typename boost::math::tools::promote_arg<typename std::iterator_traits<RAIter>::value_type>::type;
+
+    detail::check_coordinates(x_begin, x_end, y_begin, y_end);
+    return -detail::polygonal_area_sum<Real>(x_begin, y_begin, nodes_begin, nodes_end, summation) / 2;
+}
+
 template <typename RAIter, typename RAIter2>
-auto polygonal_area (RAIter x_begin, RAIter x_end, RAIter y_begin, RAIter y_end, RAIter2 nodes_begin, RAIter2 nodes_end)
+inline auto polygonal_area (RAIter x_begin, RAIter x_end, RAIter y_begin, RAIter y_end, RAIter2 nodes_begin, RAIter2 nodes_end)
+{
+    return polygonal_area(x_begin, x_end, y_begin, y_end, nodes_begin, nodes_end, naive_summation());
+}
+
+// Returns the signed area of the polygon whose vertices are x[i], y[i] taken in order
+template <typename RAIter, typename Summation,
+          typename std::enable_if<detail::is_summation_policy<Summation>::value, bool>::type = true>
+auto polygonal_area (RAIter x_begin, RAIter x_end, RAIter y_begin, RAIter y_end, const Summation& summation)
+{
+    using Real = typename boost::math::tools::promote_arg<typename std::iterator_traits<RAIter>::value_type>::type;
+
+    detail::check_coordinates(x_begin, x_end, y_begin, y_end);
+    const auto n = static_cast<std::size_t>(std::distance(x_begin, x_end));
+
+    return -detail::polygonal_area_sum<Real>(x_begin, y_begin, detail::identity_nodes(), n, summation) / 2;
+}
+
+template <typename RAIter>
+inline auto polygonal_area (RAIter x_begin, RAIter x_end, RAIter y_begin, RAIter y_end)
+{
+    return polygonal_area(x_begin, x_end, y_begin, y_end, naive_summation());
+}
+
+// Writes the signed areas of many curves sharing one set of coordinates.
+// The curves are stored CSR-style: curve i is nodes[offsets[i]], ..., nodes[offsets[i+1] - 1],
+// so there is one more offset than there are curves, and the offsets must not decrease or pass the
+// last node.
+template <typename RAIter, typename RAIter2, typename RAIter3, typename OutputIter, typename Summation,
+          typename std::enable_if<detail::is_summation_policy<Summation>::value, bool>::type = true>
+OutputIter polygonal_area (RAIter x_begin, RAIter x_end, RAIter y_begin, RAIter y_end,
+                           RAIter2 nodes_begin, RAIter2 nodes_end, RAIter3 offsets_begin, RAIter3 offsets_end,
+                           OutputIter out, const Summation& summation)
 {
     using Real = typename boost::math::tools::promote_arg<typename std::iterator_traits<RAIter>::value_type>::type;
 
-    const auto node_length = std::distance(nodes_begin, nodes_end);
+    detail::check_coordinates(x_begin, x_end, y_begin, y_end);
+    if (offsets_begin == offsets_end)
+    {
+        return out;
+    }
+    detail::check_offsets(offsets_begin, offsets_end, std::distance(nodes_begin, nodes_end));
 
-    if (node_length <= 3)
+    auto curve_end = std::next(nodes_begin, *offsets_begin);
+    for (auto it = std::next(offsets_begin); it != offsets_end; ++it)
     {
-        return static_cast<Real>(0);
+        const auto curve_begin = curve_end;
+        curve_end = std::next(nodes_begin, *it);
+
+        *out = -detail::polygonal_area_sum<Real>(x_begin, y_begin, curve_begin, curve_end, summation) / 2;
+        ++out;
     }
 
-    Real area = 0;
-    auto node_2 = *nodes_end;
-    while (nodes_begin != nodes_end)
+    return out;
+}
+
+template <typename RAIter, typename RAIter2, typename RAIter3, typename OutputIter>
+inline OutputIter polygonal_area (RAIter x_begin, RAIter x_end, RAIter y_begin, RAIter y_end,
+                                  RAIter2 nodes_begin, RAIter2 nodes_end, RAIter3 offsets_begin, RAIter3 offsets_end,
+                                  OutputIter out)
+{
+    return polygonal_area(x_begin, x_end, y_begin, y_end, nodes_begin, nodes_end, offsets_begin, offsets_end,
+                          out, naive_summation());
+}
+
+// The container overloads take their arguments by const reference, so any container or span-like view
+// (including one over a memory mapped buffer) is read in place without a copy or an allocation.
+template <typename RAContainer, typename RAContainer2, typename Summation = naive_summation,
+          typename std::enable_if<detail::is_summation_policy<Summation>::value, bool>::type = true>
+inline auto polygonal_area (const RAContainer& x, const RAContainer& y, const RAContainer2& nodes,
+                            const Summation& summation = Summation())
+{
+    const auto x_begin = detail::contiguous_begin(x, 0);
+    const auto y_begin = detail::contiguous_begin(y, 0);
+    const auto nodes_begin = detail::contiguous_begin(nodes, 0);
+
+    return polygonal_area(x_begin, std::next(x_begin, std::distance(std::cbegin(x), std::cend(x))),
+                          y_begin, std::next(y_begin, std::distance(std::cbegin(y), std::cend(y))),
+                          nodes_begin, std::next(nodes_begin, std::distance(std::cbegin(nodes), std::cend(nodes))),
+                          summation);
+}
+
+template <typename RAContainer, typename RAContainer2, typename RAContainer3, typename OutputIter,
+          typename Summation = naive_summation,
+          typename std::enable_if<detail::is_summation_policy<Summation>::value &&
+                                  !detail::is_summation_policy<OutputIter>::value, bool>::type = true>
+inline OutputIter polygonal_area (const RAContainer& x, const RAContainer& y, const RAContainer2& nodes,
+                                  const RAContainer3& offsets, OutputIter out, const Summation& summation = Summation())
+{
+    const auto x_begin = detail::contiguous_begin(x, 0);
+    const auto y_begin = detail::contiguous_begin(y, 0);
+    const auto nodes_begin = detail::contiguous_begin(nodes, 0);
+
+    return polygonal_area(x_begin, std::next(x_begin, std::distance(std::cbegin(x), std::cend(x))),
+                          y_begin, std::next(y_begin, std::distance(std::cbegin(y), std::cend(y))),
+                          nodes_begin, std::next(nodes_begin, std::distance(std::cbegin(nodes), std::cend(nodes))),
+                          std::cbegin(offsets), std::cend(offsets), out, summation);
+}
+
+// Fixed-size polygons: the overloads on std::array are constexpr, so that the area of a stencil known at
+// compile time is folded by the compiler, and otherwise give the results of the container overloads on
+// the same data. compensated_summation relies on std::fma, which is not constexpr, so it is evaluated at
+// run time.
+template <typename Real, std::size_t N, typename Summation = naive_summation,
+          typename std::enable_if<detail::is_summation_policy<Summation>::value, bool>::type = true>
+constexpr auto polygonal_area (const std::array<Real, N>& x, const std::array<Real, N>& y, const Summation& summation = Summation())
+{
+    using Promoted = typename boost::math::tools::promote_arg<Real>::type;
+
+    return -detail::polygonal_area_sum<Promoted>(detail::array_elements<Real, N> {&x}, detail::array_elements<Real, N> {&y},
+                                                 detail::identity_nodes(), N, summation) / 2;
+}
+
+template <typename Real, std::size_t N, typename Node, std::size_t M, typename Summation = naive_summation,
+          typename std::enable_if<detail::is_summation_policy<Summation>::value, bool>::type = true>
+constexpr auto polygonal_area (const std::array<Real, N>& x, const std::array<Real, N>& y, const std::array<Node, M>& nodes,
+                               const Summation& summation = Summation())
+{
+    using Promoted = typename boost::math::tools::promote_arg<Real>::type;
+
+    return -detail::polygonal_area_sum<Promoted>(detail::array_elements<Real, N> {&x}, detail::array_elements<Real, N> {&y},
+                                                 detail::node_list<detail::array_elements<Node, M>> {{&nodes}}, M, summation) / 2;
+}
+
+namespace detail {
+
+// Twice the signed area of the triangle (a, b, c): positive if the vertices are counterclockwise
+template <typename Real>
+constexpr Real orient2d (Real ax, Real ay, Real bx, Real by, Real cx, Real cy)
+{
+    return (bx - ax) * (cy - ay) - (by - ay) * (cx - ax);
+}
+
+// Positive if d lies inside the circle through the counterclockwise triangle (a, b, c),
+// negative if it lies outside and zero if the four points are cocircular
+template <typename Real>
+constexpr Real incircle (Real ax, Real ay, Real bx, Real by, Real cx, Real cy, Real dx, Real dy)
+{
+    const Real adx = ax - dx;
+    const Real ady = ay - dy;
+    const Real bdx = bx - dx;
+    const Real bdy = by - dy;
+    const Real cdx = cx - dx;
+    const Real cdy = cy - dy;
+
+    const Real alift = adx * adx + ady * ady;
+    const Real blift = bdx * bdx + bdy * bdy;
+    const Real clift = cdx * cdx + cdy * cdy;
+
+    return alift * (bdx * cdy - bdy * cdx) +
+           blift * (cdx * ady - cdy * adx) +
+           clift * (adx * bdy - ady * bdx);
+}
+
+// Expansion arithmetic (Shewchuk, Adaptive precision floating-point arithmetic and fast robust geometric
+// predicates, Discrete Comput. Geom. 18 (1997)): a number held exactly as the sum of nonoverlapping
+// components in increasing order of magnitude, without zeros, so that its sign is that of its last
+// component. The operations are exact under round to nearest, barring overflow and underflow, and each
+// expansion has room for the longest result of the operations that build it.
+template <typename Real, std::size_t N>
+struct expansion
+{
+    Real terms[N];
+    std::size_t size = 0;
+
+    void push (Real term)
+    {
+        if (term != 0)
+        {
+            terms[size++] = term;
+        }
+    }
+
+    // The sum of the components, from the smallest, which has the sign of the exact value
+    Real estimate () const
+    {
+        Real sum = 0;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            sum += terms[i];
+        }
+        return sum;
+    }
+};
+
+// h = e + f (FAST-EXPANSION-SUM-ZEROELIM): the components of both, merged by magnitude, are swept
+// with TwoSum, which keeps every rounding error as a component
+template <typename Real>
+std::size_t expansion_sum (const Real* e, std::size_t e_size, const Real* f, std::size_t f_size, Real* h)
+{
+    using std::fabs;
+
+    std::size_t i = 0;
+    std::size_t j = 0;
+    const auto next = [&]()
     {
-        auto node_1 = node_2;
-        node_2 = nodes_begin;
+        return j == f_size || (i < e_size && fabs(e[i]) < fabs(f[j])) ? e[i++] : f[j++];
+    };
 
-        area += (*std::next(x_begin, node_2) - *std::next(x_begin, node_1)) *
-                (*std::next(y_begin, node_1) + *std::next(y_begin, node_2));
+    std::size_t size = 0;
+    if (e_size + f_size == 0)
+    {
+        return size;
+    }
+    Real q = next();
+    for (std::size_t k = 1; k < e_size + f_size; ++k)
+    {
+        const Real g = next();
+        const Real sum = q + g;
+        const Real error = two_sum_error(q, g, sum);
+        if (error != 0)
+        {
+            h[size++] = error;
+        }
+        q = sum;
+    }
+    if (q != 0)
+    {
+        h[size++] = q;
+    }
+
+    return size;
+}
+
+// h = e b (SCALE-EXPANSION-ZEROELIM), with the products split exactly by fma
+template <typename Real>
+std::size_t expansion_scale (const Real* e, std::size_t e_size, Real b, Real* h)
+{
+    using std::fma;
+
+    std::size_t size = 0;
+    if (e_size == 0 || b == 0)
+    {
+        return size;
+    }
+    Real q = e[0] * b;
+    const auto push = [&](Real term)
+    {
+        if (term != 0)
+        {
+            h[size++] = term;
+        }
+    };
+    push(fma(e[0], b, -q));
+    for (std::size_t i = 1; i < e_size; ++i)
+    {
+        const Real product = e[i] * b;
+        const Real product_error = fma(e[i], b, -product);
+        const Real sum = q + product_error;
+        push(two_sum_error(q, product_error, sum));
+        q = product + sum;
+        push(two_sum_error(product, sum, q));
+    }
+    push(q);
+
+    return size;
+}
+
+template <typename Real, std::size_t N, std::size_t M>
+expansion<Real, N + M> operator+ (const expansion<Real, N>& e, const expansion<Real, M>& f)
+{
+    expansion<Real, N + M> h;
+    h.size = expansion_sum(e.terms, e.size, f.terms, f.size, h.terms);
+    return h;
+}
+
+template <typename Real, std::size_t N, std::size_t M>
+expansion<Real, N + M> operator- (const expansion<Real, N>& e, const expansion<Real, M>& f)
+{
+    expansion<Real, M> negated;
+    negated.size = f.size;
+    for (std::size_t i = 0; i < f.size; ++i)
+    {
+        negated.terms[i] = -f.terms[i];
+    }
+    return e + negated;
+}
+
+// The sum of e scaled by each component of f
+template <typename Real, std::size_t N, std::size_t M>
+expansion<Real, 2 * N * M> operator* (const expansion<Real, N>& e, const expansion<Real, M>& f)
+{
+    expansion<Real, 2 * N * M> h;
+    if (f.size == 1)
+    {
+        h.size = expansion_scale(e.terms, e.size, f.terms[0], h.terms);
+        return h;
+    }
+
+    // The partial sums alternate between h and a second buffer
+    Real partial[2 * N * M];
+    Real scaled[2 * N];
+    Real* sum = f.size % 2 == 1 ? h.terms : partial;
+    Real* other = f.size % 2 == 1 ? partial : h.terms;
+    std::size_t size = 0;
+    for (std::size_t j = 0; j < f.size; ++j)
+    {
+        const std::size_t scaled_size = expansion_scale(e.terms, e.size, f.terms[j], scaled);
+        size = expansion_sum(other, size, scaled, scaled_size, sum);
+        std::swap(sum, other);
+    }
+    h.size = size;
+    return h;
+}
+
+// a - b exactly
+template <typename Real>
+expansion<Real, 2> exact_difference (Real a, Real b)
+{
+    expansion<Real, 2> h;
+    const Real difference = a - b;
+    h.push(two_sum_error(a, -b, difference));
+    h.push(difference);
+    return h;
+}
+
+// Shewchuk's bounds on the rounding error of orient2d and incircle, relative to their permanents
+template <typename Real>
+constexpr Real orient2d_error_bound ()
+{
+    return (3 + 8 * std::numeric_limits<Real>::epsilon()) * std::numeric_limits<Real>::epsilon() / 2;
+}
+
+template <typename Real>
+constexpr Real incircle_error_bound ()
+{
+    return (10 + 48 * std::numeric_limits<Real>::epsilon()) * std::numeric_limits<Real>::epsilon() / 2;
+}
+
+// The determinants in expansion arithmetic, kept out of line so that the filters inline into the walks,
+// and counted under the Statistics policy collect_statistics
+template <typename Statistics, typename Real>
+BOOST_NOINLINE Real exact_orient2d (Real ax, Real ay, Real bx, Real by, Real cx, Real cy)
+{
+    count_exact_predicate<Statistics>(&exact_predicate_counts::orient2d);
+    const auto bax = exact_difference(bx, ax);
+    const auto bay = exact_difference(by, ay);
+    const auto cax = exact_difference(cx, ax);
+    const auto cay = exact_difference(cy, ay);
+    return (bax * cay - bay * cax).estimate();
+}
+
+template <typename Statistics, typename Real>
+BOOST_NOINLINE Real exact_incircle (Real ax, Real ay, Real bx, Real by, Real cx, Real cy, Real dx, Real dy)
+{
+    count_exact_predicate<Statistics>(&exact_predicate_counts::incircle);
+    const auto adx = exact_difference(ax, dx);
+    const auto ady = exact_difference(ay, dy);
+    const auto bdx = exact_difference(bx, dx);
+    const auto bdy = exact_difference(by, dy);
+    const auto cdx = exact_difference(cx, dx);
+    const auto cdy = exact_difference(cy, dy);
+    const auto alift = adx * adx + ady * ady;
+    const auto blift = bdx * bdx + bdy * bdy;
+    const auto clift = cdx * cdx + cdy * cdy;
+    return (alift * (bdx * cdy - bdy * cdx) + blift * (cdx * ady - cdy * adx) + clift * (adx * bdy - ady * bdx)).estimate();
+}
+
+template <typename Statistics, typename Real>
+Real robust_orient2d (Real ax, Real ay, Real bx, Real by, Real cx, Real cy, const std::false_type&)
+{
+    return orient2d(ax, ay, bx, by, cx, cy);
+}
 
-        ++nodes_begin;
+template <typename Statistics, typename Real>
+Real robust_orient2d (Real ax, Real ay, Real bx, Real by, Real cx, Real cy, const std::true_type&)
+{
+    using std::fabs;
+
+    const Real left = (bx - ax) * (cy - ay);
+    const Real right = (by - ay) * (cx - ax);
+    const Real det = left - right;
+    if (fabs(det) >= orient2d_error_bound<Real>() * (fabs(left) + fabs(right)))
+    {
+        return det;
     }
 
-    return -area / 2;
+    return exact_orient2d<Statistics>(ax, ay, bx, by, cx, cy);
+}
+
+// orient2d with the correct sign for all floating point inputs: the determinant in floating point when
+// it is larger than its error bound, as it is for all but nearly collinear points, and otherwise the
+// determinant in expansion arithmetic. Other types are evaluated as they are. The exact evaluations are
+// counted in exact_predicate_counters for the Statistics policy collect_statistics.
+template <typename Real, typename Statistics = no_statistics>
+Real robust_orient2d (Real ax, Real ay, Real bx, Real by, Real cx, Real cy)
+{
+    return robust_orient2d<Statistics>(ax, ay, bx, by, cx, cy, std::is_floating_point<Real>());
 }
 
-template <typename RAContainer, typename RAContainer2>
-inline auto polygonal_area (RAContainer x, RAContainer y, RAContainer2 nodes)
+template <typename Statistics, typename Real>
+Real robust_incircle (Real ax, Real ay, Real bx, Real by, Real cx, Real cy, Real dx, Real dy, const std::false_type&)
 {
-    return polygonal_area(std::cbegin(x), std::cend(x),
-                          std::cbegin(y), std::cend(y),
-                          std::cbegin(nodes), std::cend(nodes));
+    return incircle(ax, ay, bx, by, cx, cy, dx, dy);
 }
 
+template <typename Statistics, typename Real>
+Real robust_incircle (Real ax, Real ay, Real bx, Real by, Real cx, Real cy, Real dx, Real dy, const std::true_type&)
+{
+    using std::fabs;
+
+    const Real adx = ax - dx;
+    const Real ady = ay - dy;
+    const Real bdx = bx - dx;
+    const Real bdy = by - dy;
+    const Real cdx = cx - dx;
+    const Real cdy = cy - dy;
+
+    const Real bdxcdy = bdx * cdy;
+    const Real cdxbdy = cdx * bdy;
+    const Real cdxady = cdx * ady;
+    const Real adxcdy = adx * cdy;
+    const Real adxbdy = adx * bdy;
+    const Real bdxady = bdx * ady;
+
+    const Real alift = adx * adx + ady * ady;
+    const Real blift = bdx * bdx + bdy * bdy;
+    const Real clift = cdx * cdx + cdy * cdy;
+
+    const Real det = alift * (bdxcdy - cdxbdy) + blift * (cdxady - adxcdy) + clift * (adxbdy - bdxady);
+    const Real permanent = (fabs(bdxcdy) + fabs(cdxbdy)) * alift + (fabs(cdxady) + fabs(adxcdy)) * blift +
+                           (fabs(adxbdy) + fabs(bdxady)) * clift;
+    if (fabs(det) > incircle_error_bound<Real>() * permanent)
+    {
+        return det;
+    }
+
+    return exact_incircle<Statistics>(ax, ay, bx, by, cx, cy, dx, dy);
+}
+
+// incircle with the correct sign for all floating point inputs, filtered as robust_orient2d
+template <typename Real, typename Statistics = no_statistics>
+Real robust_incircle (Real ax, Real ay, Real bx, Real by, Real cx, Real cy, Real dx, Real dy)
+{
+    return robust_incircle<Statistics>(ax, ay, bx, by, cx, cy, dx, dy, std::is_floating_point<Real>());
+}
+
+// Position of the cell (x, y) along the Hilbert curve through a 2^order by 2^order grid
+inline std::uint64_t hilbert_index (std::uint32_t x, std::uint32_t y, int order)
+{
+    const std::uint32_t n = static_cast<std::uint32_t>(1) << order;
+
+    std::uint64_t d = 0;
+    for (std::uint32_t s = n / 2; s > 0; s /= 2)
+    {
+        const std::uint32_t rx = (x & s) > 0 ? 1 : 0;
+        const std::uint32_t ry = (y & s) > 0 ? 1 : 0;
+        d += static_cast<std::uint64_t>(s) * s * ((3 * rx) ^ ry);
+
+        if (ry == 0)
+        {
+            if (rx == 1)
+            {
+                x = n - 1 - x;
+                y = n - 1 - y;
+            }
+            std::swap(x, y);
+        }
+    }
+
+    return d;
+}
+
+// SplitMix64, a fixed and portable source of bits for the insertion rounds
+inline std::uint64_t mix_bits (std::uint64_t z)
+{
+    z += 0x9E3779B97F4A7C15u;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9u;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBu;
+    return z ^ (z >> 31);
+}
+
+// Maps points to their positions along a Hilbert curve through a 2^order by 2^order grid over a
+// bounding box, with one scale for both axes so that the curve follows anisotropic inputs. Points
+// outside of the box, including NaNs, are clamped to it.
+template <typename Real>
+class hilbert_grid
+{
+public:
+    static constexpr int order = 24;
+
+    template <typename RAIter, typename Index>
+    hilbert_grid (RAIter x, RAIter y, const std::vector<Index>& nodes)
+    {
+        for (const Index i : nodes)
+        {
+            include(x[i], y[i]);
+        }
+        finish();
+    }
+
+    template <typename RAIter>
+    hilbert_grid (RAIter x, RAIter y, std::size_t n)
+    {
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            include(x[i], y[i]);
+        }
+        finish();
+    }
+
+    std::uint64_t operator() (Real x, Real y) const
+    {
+        return hilbert_index(cell((x - x_min_) * scale_), cell((y - y_min_) * scale_), order);
+    }
+
+    // The position on the coarser curve through a 2^level by 2^level grid, which is that of the
+    // full index shifted right by 2 (order - level) bits
+    std::uint64_t operator() (Real x, Real y, int level) const
+    {
+        const int shift = order - level;
+        return hilbert_index(cell((x - x_min_) * scale_) >> shift, cell((y - y_min_) * scale_) >> shift, level);
+    }
+
+private:
+    static constexpr std::uint32_t cells = (static_cast<std::uint32_t>(1) << order) - 1;
+
+    void include (Real x, Real y)
+    {
+        x_min_ = (std::min)(x_min_, x);
+        x_max_ = (std::max)(x_max_, x);
+        y_min_ = (std::min)(y_min_, y);
+        y_max_ = (std::max)(y_max_, y);
+    }
+
+    void finish ()
+    {
+        const Real extent = (std::max)(x_max_ - x_min_, y_max_ - y_min_);
+        scale_ = extent > 0 ? static_cast<Real>(cells) / extent : Real(0);
+    }
+
+    static std::uint32_t cell (Real c)
+    {
+        return !(c > 0) ? 0 : c >= static_cast<Real>(cells) ? cells : static_cast<std::uint32_t>(c);
+    }
+
+    Real x_min_ = (std::numeric_limits<Real>::max)();
+    Real x_max_ = std::numeric_limits<Real>::lowest();
+    Real y_min_ = (std::numeric_limits<Real>::max)();
+    Real y_max_ = std::numeric_limits<Real>::lowest();
+    Real scale_ = 0;
+};
+
+template <typename Real>
+constexpr int hilbert_grid<Real>::order;
+
+template <typename Real>
+constexpr std::uint32_t hilbert_grid<Real>::cells;
+
+// Biased randomized insertion order (Amenta, Choi & Rote 2003): each node joins round r with
+// probability 2^-(r+1), the rounds are inserted from the sparsest to the densest, and within a round
+// the nodes follow a Hilbert curve. Each walk then starts near its target and the triangles touched
+// by consecutive insertions are close in memory, while the randomization keeps the expected work
+// of the incremental construction optimal. The order is fixed for a given set of nodes.
+template <typename Real, typename Index, typename RAContainer>
+std::vector<Index> brio_order (const RAContainer& x, const RAContainer& y, const std::vector<Index>& nodes)
+{
+    constexpr int max_round = 15;
+    const auto n = static_cast<Index>(nodes.size());
+    const hilbert_grid<Real> grid(x.begin(), y.begin(), nodes);
+
+    std::vector<std::pair<std::uint64_t, Index>> keys(n);
+    for (Index k = 0; k < n; ++k)
+    {
+        const Index i = nodes[k];
+        const std::uint64_t bits = mix_bits(static_cast<std::uint64_t>(i));
+        int round = 0;
+        while (round < max_round && ((bits >> round) & 1u))
+        {
+            ++round;
+        }
+
+        keys[k].first = (static_cast<std::uint64_t>(max_round - round) << (2 * hilbert_grid<Real>::order)) | grid(x[i], y[i]);
+        keys[k].second = i;
+    }
+    std::sort(keys.begin(), keys.end());
+
+    std::vector<Index> result(n);
+    for (Index i = 0; i < n; ++i)
+    {
+        result[i] = keys[i].second;
+    }
+
+    return result;
+}
+
+// The circumdisk of the counterclockwise triangle (a, b, c), with center (ux, uy) and a radius enlarged to
+// cover the rounding errors of the center and the radius: points farther than reach from the center are
+// certainly outside of the circumcircle. False if the triangle is too flat for the disk to be computed.
+template <typename Real>
+bool bounding_circumdisk (Real ax, Real ay, Real bx, Real by, Real cx, Real cy, Real& ux, Real& uy, Real& reach)
+{
+    using std::abs;
+    using std::sqrt;
+
+    bx -= ax;
+    by -= ay;
+    cx -= ax;
+    cy -= ay;
+    const Real d = 2 * (bx * cy - by * cx);
+    if (!(d > 0))
+    {
+        return false;
+    }
+    const Real b2 = bx * bx + by * by;
+    const Real c2 = cx * cx + cy * cy;
+    const Real dx = (cy * b2 - by * c2) / d;
+    const Real dy = (bx * c2 - cx * b2) / d;
+    const Real r = sqrt(dx * dx + dy * dy);
+
+    // Perturbing the vertices by delta moves the center by about delta times the condition number
+    const Real condition = 2 * (abs(bx * cy) + abs(by * cx)) / d;
+    const Real scale = r + abs(ax) + abs(ay) + abs(bx) + abs(by) + abs(cx) + abs(cy);
+    reach = r + 64 * std::numeric_limits<Real>::epsilon() * condition * scale;
+    ux = ax + dx;
+    uy = ay + dy;
+    return true;
+}
+
+// TRIPACK TRFIND on the flat arrays of a triangulation with the ghost vertex npos: returns a triangle
+// containing (x, y), walking from the triangle start, or npos if the walk does not end within a step per
+// triangle. The triangle is a ghost triangle if and only if (x, y) lies outside of the convex hull, in
+// which case (x, y) lies strictly on the outer side of its boundary edge. The number of triangles that
+// the walk crossed is written to walked, if given.
+template <typename Predicate, typename Statistics = no_statistics, typename Real, typename Index>
+Index straight_walk (const Real* px, const Real* py, const Index* vertices, const Index* neighbors, Index triangles,
+                     Real x, Real y, Index start, Index* walked = nullptr)
+{
+    constexpr Index npos = static_cast<Index>(-1);
+    Index t = start;
+    if (vertices[3 * t + 2] == npos)
+    {
+        t = neighbors[3 * t + 2];
+    }
+
+    // Straight walk along the segment from the centroid of the start triangle to (x, y)
+    // (Devillers, Pion & Teillaud 2002): each step leaves through the edge that the segment
+    // crosses, so the walk advances along the segment and terminates in any triangulation,
+    // including constrained ones. That edge is one that (x, y) lies beyond, so the segment is
+    // only needed when there are two of them; a segment through their shared vertex takes the first.
+    const Index start_triangle = t;
+    bool centered = false;
+    Real sx = 0;
+    Real sy = 0;
+    Index previous = npos;
+    for (Index steps = 0; steps <= triangles; ++steps)
+    {
+        const Index* v = vertices + 3 * t;
+        int beyond[2];
+        int count = 0;
+        for (int i = 0; i < 3 && count < 2; ++i)
+        {
+            const Index a = v[(i + 1) % 3];
+            const Index b = v[(i + 2) % 3];
+            if (neighbors[3 * t + i] != previous && robust_orient2d<Predicate, Statistics>(px[a], py[a], px[b], py[b], x, y) < 0)
+            {
+                beyond[count++] = i;
+            }
+        }
+
+        if (count == 0)
+        {
+            if (walked != nullptr)
+            {
+                *walked = steps;
+            }
+            return t;
+        }
+
+        int exit = beyond[0];
+        if (count == 2)
+        {
+            if (!centered)
+            {
+                centered = true;
+                const Index* w = vertices + 3 * start_triangle;
+                sx = (px[w[0]] + px[w[1]] + px[w[2]]) / 3;
+                sy = (py[w[0]] + py[w[1]] + py[w[2]]) / 3;
+            }
+            const Index a = v[(exit + 1) % 3];
+            const Index b = v[(exit + 2) % 3];
+            const Predicate oa = robust_orient2d<Predicate, Statistics>(sx, sy, x, y, px[a], py[a]);
+            const Predicate ob = robust_orient2d<Predicate, Statistics>(sx, sy, x, y, px[b], py[b]);
+            if ((oa < 0 && ob < 0) || (oa > 0 && ob > 0))
+            {
+                exit = beyond[1];
+            }
+        }
+
+        previous = t;
+        t = neighbors[3 * t + exit];
+        if (vertices[3 * t + 2] == npos)
+        {
+            if (walked != nullptr)
+            {
+                *walked = steps + 1;
+            }
+            return t;
+        }
+    }
+
+    if (walked != nullptr)
+    {
+        *walked = triangles + 1;
+    }
+    return npos;
+}
+
+// The triangle containing (x, y) by testing every triangle, for when rounding defeats the walk
+template <typename Predicate, typename Statistics = no_statistics, typename Real, typename Index>
+Index exhaustive_search (const Real* px, const Real* py, const Index* vertices, Index triangles, Real x, Real y)
+{
+    constexpr Index npos = static_cast<Index>(-1);
+    Index outside = npos;
+    for (Index t = 0; t < triangles; ++t)
+    {
+        const Index* v = vertices + 3 * t;
+        if (v[2] == npos)
+        {
+            if (outside == npos && robust_orient2d<Predicate, Statistics>(px[v[1]], py[v[1]], px[v[0]], py[v[0]], x, y) < 0)
+            {
+                outside = t;
+            }
+        }
+        else if (robust_orient2d<Predicate, Statistics>(px[v[0]], py[v[0]], px[v[1]], py[v[1]], x, y) >= 0 &&
+                 robust_orient2d<Predicate, Statistics>(px[v[1]], py[v[1]], px[v[2]], py[v[2]], x, y) >= 0 &&
+                 robust_orient2d<Predicate, Statistics>(px[v[2]], py[v[2]], px[v[0]], py[v[0]], x, y) >= 0)
+        {
+            return t;
+        }
+    }
+
+    return outside;
+}
+
+// The coordinates of, or values at, the nodes: a vector that the owner fills or adopts from the caller,
+// or an array borrowed from the caller, which must outlive the owner and is never written. Reads go
+// through one pointer either way; the writes, which appending and removing nodes need, throw when the
+// array is borrowed.
+template <typename Real, typename Allocator = std::allocator<Real>>
+class node_array
+{
+public:
+    using storage_type = std::vector<Real, typename std::allocator_traits<Allocator>::template rebind_alloc<Real>>;
+
+    explicit node_array (const Allocator& alloc = Allocator())
+        : owned_(alloc)
+    {}
+
+    explicit node_array (storage_type&& owned) noexcept
+        : owned_(std::move(owned)), data_ {owned_.data()}, size_ {owned_.size()}
+    {}
+
+    node_array (const Real* borrowed, std::size_t size, const Allocator& alloc = Allocator())
+        : owned_(alloc), data_ {borrowed}, size_ {size}, borrowed_ {true}
+    {}
+
+    node_array (const node_array& other)
+        : owned_(other.owned_), data_ {other.borrowed_ ? other.data_ : owned_.data()}, size_ {other.size_}, borrowed_ {other.borrowed_}
+    {}
+
+    node_array (node_array&& other) noexcept
+        : owned_(std::move(other.owned_)), data_ {other.borrowed_ ? other.data_ : owned_.data()}, size_ {other.size_}, borrowed_ {other.borrowed_}
+    {}
+
+    node_array& operator= (const node_array& other)
+    {
+        return *this = node_array(other);
+    }
+
+    node_array& operator= (node_array&& other) noexcept
+    {
+        owned_ = std::move(other.owned_);
+        data_ = other.borrowed_ ? other.data_ : owned_.data();
+        size_ = other.size_;
+        borrowed_ = other.borrowed_;
+        return *this;
+    }
+
+    // The buffer of a vector of storage_type, without copying it, or a copy of any other container
+    static storage_type adopt (storage_type&& c) noexcept
+    {
+        return std::move(c);
+    }
+
+    template <typename RAContainer>
+    static storage_type adopt (const RAContainer& c)
+    {
+        return storage_type(std::cbegin(c), std::cend(c));
+    }
+
+    const Real& operator[] (std::size_t i) const
+    {
+        return data_[i];
+    }
+
+    const Real* data () const
+    {
+        return data_;
+    }
+
+    const Real* begin () const
+    {
+        return data_;
+    }
+
+    const Real* end () const
+    {
+        return data_ + size_;
+    }
+
+    std::size_t size () const
+    {
+        return size_;
+    }
+
+    // Borrowed arrays hold no memory of their own
+    std::size_t capacity () const
+    {
+        return owned_.capacity();
+    }
+
+    Allocator get_allocator () const
+    {
+        return Allocator(owned_.get_allocator());
+    }
+
+    bool borrowed () const
+    {
+        return borrowed_;
+    }
+
+    void reserve (std::size_t n)
+    {
+        check_owned();
+        owned_.reserve(n);
+        data_ = owned_.data();
+    }
+
+    void push_back (Real value)
+    {
+        check_owned();
+        owned_.push_back(value);
+        data_ = owned_.data();
+        ++size_;
+    }
+
+    void pop_back ()
+    {
+        check_owned();
+        owned_.pop_back();
+        --size_;
+    }
+
+    void set (std::size_t i, Real value)
+    {
+        check_owned();
+        owned_[i] = value;
+    }
+
+    void check_owned () const
+    {
+        if (borrowed_)
+        {
+            throw std::domain_error("The nodes are borrowed from the caller and cannot be changed.");
+        }
+    }
+
+private:
+    storage_type owned_;
+    const Real* data_ = nullptr;
+    std::size_t size_ = 0;
+    bool borrowed_ = false;
+};
+
+// Delaunay triangulation of a set of nodes in the plane, with optional constraint curves.
+//
+// The structure is flat and index based: triangle t has the counterclockwise vertices
+// vertex(t, 0), vertex(t, 1), vertex(t, 2), and neighbor(t, i) is the triangle across the edge
+// opposite vertex(t, i). The convex hull is closed by ghost triangles, which join each boundary
+// edge to a ghost vertex (npos) stored in slot 2, so every triangle has three neighbors and
+// nodes outside of the hull are inserted like nodes inside of it.
+//
+// Construction follows TRIPACK: nodes are added one at a time (ADDNOD) by locating the triangle
+// that contains them (TRFIND), splitting it, and swapping arcs until the triangulation is Delaunay;
+// constraint curves are then forced into the triangulation by swapping the arcs they cross (ADDCST).
+// The constructor inserts the nodes in a biased randomized Hilbert order rather than the input order;
+// node indices are those of the input either way. Given an executor, the constructor instead splits
+// large inputs into cells that are triangulated concurrently and stitched along their seams.
+//
+// Nodes and triangles are numbered with Index, which halves the adjacency when 32 bits suffice: up to
+// about 700 million nodes, beyond which construction throws and a 64-bit Index is needed. The
+// coordinates are stored as Real and the predicates evaluated in predicate_type, by robust_orient2d and
+// robust_incircle, so that the topology is exact however nearly collinear or cocircular the nodes are.
+//
+// The coordinates are copied from the input, except that vectors of the storage type passed as rvalues
+// are adopted as they are, and with borrow_nodes the arrays of the caller are read in place.
+//
+// The arrays of the triangulation are obtained from Allocator, rebound to their element types. The
+// construction reserves them once for the 2n - 2 triangles of n nodes, so that with an arena, such as a
+// boost::container::pmr::monotonic_buffer_resource of construction_bytes(n) bytes behind a
+// polymorphic_allocator, it draws a handful of blocks from the arena and the teardown returns nothing
+// to it. The temporaries of construction, among them the cells that the executor triangulates
+// concurrently, use the standard allocator, so the allocator need not be thread safe.
+//
+// With the Statistics policy collect_statistics, statistics() reports the triangles crossed by each walk,
+// the arcs swapped, the predicates evaluated exactly and the seconds of each phase of construction; with
+// no_statistics, the default, the counters and their updates are compiled out.
+template <typename Real, typename Index = std::uint32_t, typename Allocator = std::allocator<Real>, typename Statistics = no_statistics>
+class triangulation
+{
+    static_assert(std::is_unsigned<Index>::value, "The index type must be an unsigned integer type.");
+
+    template <typename T>
+    using storage = std::vector<T, typename std::allocator_traits<Allocator>::template rebind_alloc<T>>;
+
+public:
+    using index_type = Index;
+    using allocator_type = Allocator;
+    using statistics_policy = Statistics;
+
+    // The type of the orientation and incircle tests, the wider of Real and double by promote_args: double
+    // for float coordinates, whose differences and products it holds almost exactly, so that float storage
+    // does not cost robustness
+    using predicate_type = typename boost::math::tools::promote_args<Real, double>::type;
+
+    // The ghost vertex and the absence of a triangle
+    static constexpr index_type npos = static_cast<index_type>(-1);
+
+    // TRIPACK TRMESH
+    template <typename RAIter>
+    triangulation (RAIter x_begin, RAIter x_end, RAIter y_begin, RAIter y_end)
+        : triangulation(std::allocator_arg, Allocator(), x_begin, x_end, y_begin, y_end)
+    {}
+
+    template <typename RAContainer>
+    triangulation (const RAContainer& x, const RAContainer& y)
+        : triangulation(std::cbegin(x), std::cend(x), std::cbegin(y), std::cend(y))
+    {}
+
+    template <typename RAIter>
+    triangulation (std::allocator_arg_t, const Allocator& alloc, RAIter x_begin, RAIter x_end, RAIter y_begin, RAIter y_end)
+        : triangulation(alloc)
+    {
+        const statistics_scope scope(stats_);
+        assign(x_begin, x_end, y_begin, y_end);
+        build(all_nodes());
+    }
+
+    template <typename RAContainer>
+    triangulation (std::allocator_arg_t, const Allocator& alloc, const RAContainer& x, const RAContainer& y)
+        : triangulation(std::allocator_arg, alloc, std::cbegin(x), std::cend(x), std::cbegin(y), std::cend(y))
+    {}
+
+    // Adopts the vectors as the coordinates of the nodes, without copying them
+    triangulation (storage<Real>&& x, storage<Real>&& y)
+        : triangulation(x.get_allocator())
+    {
+        const statistics_scope scope(stats_);
+        assign(node_array<Real, Allocator>(std::move(x)), node_array<Real, Allocator>(std::move(y)));
+        build(all_nodes());
+    }
+
+    // Borrows the n coordinates at x and y, which must outlive the triangulation and not change. Nodes
+    // cannot then be added or removed, but constraint curves can.
+    triangulation (borrow_nodes_t, const Real* x, const Real* y, std::size_t n)
+        : triangulation(Allocator())
+    {
+        const statistics_scope scope(stats_);
+        assign(node_array<Real, Allocator>(x, n), node_array<Real, Allocator>(y, n));
+        build(all_nodes());
+    }
+
+    // Divide and conquer construction: the nodes are partitioned into cells of a fixed number of nodes,
+    // the cells are triangulated as tasks of the executor (see thread_executor.hpp), and the seams between
+    // them are triangulated and stitched in. The partition depends on the nodes alone, so the result is
+    // the same whatever the executor and its number of threads; it is a Delaunay triangulation of the
+    // nodes, the one built by the serial constructor unless four or more nodes are cocircular.
+    template <typename RAIter, typename Executor>
+    triangulation (RAIter x_begin, RAIter x_end, RAIter y_begin, RAIter y_end, Executor&& executor)
+        : triangulation(std::allocator_arg, Allocator(), x_begin, x_end, y_begin, y_end, std::forward<Executor>(executor))
+    {}
+
+    template <typename RAContainer, typename Executor>
+    triangulation (const RAContainer& x, const RAContainer& y, Executor&& executor)
+        : triangulation(std::cbegin(x), std::cend(x), std::cbegin(y), std::cend(y), std::forward<Executor>(executor))
+    {}
+
+    template <typename RAIter, typename Executor>
+    triangulation (std::allocator_arg_t, const Allocator& alloc, RAIter x_begin, RAIter x_end, RAIter y_begin, RAIter y_end, Executor&& executor)
+        : triangulation(alloc)
+    {
+        const statistics_scope scope(stats_);
+        assign(x_begin, x_end, y_begin, y_end);
+        build_partitioned(executor);
+    }
+
+    template <typename RAContainer, typename Executor>
+    triangulation (std::allocator_arg_t, const Allocator& alloc, const RAContainer& x, const RAContainer& y, Executor&& executor)
+        : triangulation(std::allocator_arg, alloc, std::cbegin(x), std::cend(x), std::cbegin(y), std::cend(y), std::forward<Executor>(executor))
+    {}
+
+    template <typename Executor>
+    triangulation (storage<Real>&& x, storage<Real>&& y, Executor&& executor)
+        : triangulation(x.get_allocator())
+    {
+        const statistics_scope scope(stats_);
+        assign(node_array<Real, Allocator>(std::move(x)), node_array<Real, Allocator>(std::move(y)));
+        build_partitioned(executor);
+    }
+
+    template <typename Executor>
+    triangulation (borrow_nodes_t, const Real* x, const Real* y, std::size_t n, Executor&& executor)
+        : triangulation(Allocator())
+    {
+        const statistics_scope scope(stats_);
+        assign(node_array<Real, Allocator>(x, n), node_array<Real, Allocator>(y, n));
+        build_partitioned(executor);
+    }
+
+    allocator_type get_allocator () const
+    {
+        return allocator_type(x_.get_allocator());
+    }
+
+    // An upper bound on the bytes that the serial construction draws from the allocator for n nodes,
+    // including the padding of each block to the alignment of std::max_align_t: the size of an arena
+    // from which it needs nothing more. Adding nodes or constraints later grows the arrays.
+    static constexpr std::size_t construction_bytes (std::size_t n)
+    {
+        return 2 * n * sizeof(Real) + (13 * n + 2 + stack_reserve) * sizeof(index_type) + 2 * n +
+               9 * alignof(std::max_align_t);
+    }
+
+    // TRIPACK ADDNOD: adds the node (x, y), walking from the triangle start, and returns its index.
+    // The triangles written are exactly those of which it is a vertex.
+    index_type add_node (Real x, Real y, index_type start)
+    {
+        check_capacity(static_cast<std::size_t>(size()) + 1);
+        x_.check_owned();
+        const index_type v = size();
+        x_.push_back(x);
+        y_.push_back(y);
+        incident_.push_back(npos);
+
+        const statistics_scope scope(stats_);
+        try
+        {
+            insert(v, start);
+        }
+        catch (...)
+        {
+            x_.pop_back();
+            y_.pop_back();
+            incident_.pop_back();
+            throw;
+        }
+        if (holes_)
+        {
+            mark_star(v);
+        }
+
+        return v;
+    }
+
+    index_type add_node (Real x, Real y)
+    {
+        return add_node(x, y, last_);
+    }
+
+    // TRIPACK DELNOD: removes node v, which must not be a node of a constraint curve, and fills its star
+    // with the Delaunay triangulation of its neighbors: their polygon for an interior node, and the region
+    // between them and their convex hull for a node of the hull. As in DELNOD, the last node then takes
+    // the index v. Writes the triangles whose vertices changed other than by that renumbering, possibly
+    // more than once, and returns the iterator past them.
+    template <typename OutputIter>
+    OutputIter remove_node (index_type v, OutputIter changed)
+    {
+        if (v >= size())
+        {
+            std::ostringstream oss;
+            oss << "Node " << v << " is not a node of the triangulation, which has " << size() << " nodes.";
+            throw std::domain_error(oss.str());
+        }
+        if (size() <= 3)
+        {
+            throw std::domain_error("At least three nodes are required.");
+        }
+        x_.check_owned();
+        if (std::find(constraint_nodes_.begin(), constraint_nodes_.end(), v) != constraint_nodes_.end())
+        {
+            std::ostringstream oss;
+            oss << "Node " << v << " is a node of a constraint curve and cannot be removed.";
+            throw std::domain_error(oss.str());
+        }
+        const statistics_scope scope(stats_);
+
+        // The neighbors and the triangles around v, counterclockwise, both starting after the ghost
+        // vertex for a node of the hull
+        std::vector<index_type> ring;
+        neighbors(v, std::back_inserter(ring));
+        std::vector<index_type> star;
+        index_type t = incident_[v];
+        const index_type start = t;
+        do
+        {
+            if (vertices_[3 * t + (slot(t, v) + 1) % 3] == npos)
+            {
+                break;
+            }
+            t = neighbors_[3 * t + (slot(t, v) + 1) % 3];
+        } while (t != start);
+        const index_type first = t;
+        do
+        {
+            star.push_back(t);
+            t = neighbors_[3 * t + (slot(t, v) + 1) % 3];
+        } while (t != first);
+        const bool closed = star.size() == ring.size();
+        const bool hole = in_hole(*std::find_if(star.begin(), star.end(), [this](index_type s) { return !is_ghost(s); }));
+
+        if (!closed && ring.size() + 1 == size() &&
+            std::all_of(ring.begin(), ring.end(), [&](index_type r) { return orient(ring.front(), ring.back(), r) == 0; }))
+        {
+            std::ostringstream oss;
+            oss << "Removing node " << v << " would leave all nodes collinear.";
+            throw std::domain_error(oss.str());
+        }
+
+        // The edges of the star opposite v, with the triangles across them and their slots there
+        struct cavity_edge
+        {
+            index_type from;
+            index_type to;
+            index_type outer;
+            index_type side;
+            bool constrained;
+        };
+        std::vector<cavity_edge> boundary;
+        for (const index_type s : star)
+        {
+            const int k = slot(s, v);
+            const index_type a = vertices_[3 * s + (k + 1) % 3];
+            const index_type b = vertices_[3 * s + (k + 2) % 3];
+            const index_type u = neighbors_[3 * s + k];
+            boundary.push_back({a, b, u, 3 * u + static_cast<index_type>(3 - slot(u, a) - slot(u, b)), is_constrained(s, k)});
+        }
+
+        // Clip ears whose circumcircles hold no other neighbor; rounding may leave none, and then any
+        // ear free of neighbors is clipped and the arcs are swapped afterwards
+        std::vector<index_type> created;
+        std::vector<index_type> polygon = ring;
+        auto is_ear = [&](std::size_t i, bool delaunay)
+        {
+            const index_type a = polygon[(i + polygon.size() - 1) % polygon.size()];
+            const index_type b = polygon[i];
+            const index_type c = polygon[(i + 1) % polygon.size()];
+            if (!(orient(a, b, c) > 0))
+            {
+                return false;
+            }
+            for (const index_type r : ring)
+            {
+                if (r != a && r != b && r != c &&
+                    (delaunay ? robust_incircle<predicate_type, Statistics>(x_[a], y_[a], x_[b], y_[b], x_[c], y_[c], x_[r], y_[r]) > 0
+                              : orient(a, b, r) >= 0 && orient(b, c, r) >= 0 && orient(c, a, r) >= 0))
+                {
+                    return false;
+                }
+            }
+            return true;
+        };
+        const std::size_t ends = closed ? 0 : 1;
+        while (polygon.size() > (closed ? 3 : 2))
+        {
+            std::size_t ear = polygon.size();
+            for (const bool delaunay : {true, false})
+            {
+                for (std::size_t i = ends; i + ends < polygon.size() && ear == polygon.size(); ++i)
+                {
+                    if (is_ear(i, delaunay))
+                    {
+                        ear = i;
+                    }
+                }
+            }
+            if (ear == polygon.size())
+            {
+                if (!closed)
+                {
+                    break;
+                }
+                ear = 0;
+            }
+
+            created.push_back(polygon[(ear + polygon.size() - 1) % polygon.size()]);
+            created.push_back(polygon[ear]);
+            created.push_back(polygon[(ear + 1) % polygon.size()]);
+            polygon.erase(polygon.begin() + static_cast<std::ptrdiff_t>(ear));
+        }
+        if (closed)
+        {
+            created.insert(created.end(), polygon.begin(), polygon.end());
+        }
+        else
+        {
+            for (std::size_t i = 0; i + 1 < polygon.size(); ++i)
+            {
+                created.push_back(polygon[i]);
+                created.push_back(polygon[i + 1]);
+                created.push_back(npos);
+            }
+        }
+
+        // Two fewer triangles, in the slots of the star, joined to each other and to the triangles across
+        // the boundary of the star
+        const index_type count = static_cast<index_type>(created.size() / 3);
+        std::vector<index_type> written(star.begin(), star.begin() + static_cast<std::ptrdiff_t>(count));
+        std::vector<std::pair<index_type, index_type>> arcs;
+        for (index_type j = 0; j < count; ++j)
+        {
+            const index_type* w = &created[3 * j];
+            index_type adjacent[3];
+            bool constrained[3] = {false, false, false};
+            for (int i = 0; i < 3; ++i)
+            {
+                const index_type a = w[(i + 1) % 3];
+                const index_type b = w[(i + 2) % 3];
+                adjacent[i] = npos;
+                for (const cavity_edge& e : boundary)
+                {
+                    if (e.from == a && e.to == b)
+                    {
+                        adjacent[i] = e.outer;
+                        constrained[i] = e.constrained;
+                        neighbors_[e.side] = star[j];
+                    }
+                }
+                for (index_type k = 0; k < count && adjacent[i] == npos; ++k)
+                {
+                    const index_type* u = &created[3 * k];
+                    for (int l = 0; l < 3; ++l)
+                    {
+                        if (u[(l + 1) % 3] == b && u[(l + 2) % 3] == a)
+                        {
+                            adjacent[i] = star[k];
+                        }
+                    }
+                }
+                if (a != npos && b != npos)
+                {
+                    arcs.emplace_back(a, b);
+                }
+            }
+            set_triangle(star[j], w[0], w[1], w[2], adjacent[0], adjacent[1], adjacent[2], constrained[0], constrained[1], constrained[2]);
+        }
+        swap_illegal_arcs(arcs, [&written](index_type s, index_type u)
+        {
+            written.push_back(s);
+            written.push_back(u);
+        });
+
+        // The arcs of v are not constrained, so its star lay in one region
+        if (hole)
+        {
+            for (const index_type s : written)
+            {
+                if (!is_ghost(s))
+                {
+                    constraints_[s] |= 8u;
+                }
+            }
+        }
+
+        const index_type last_node = size() - 1;
+        if (v != last_node)
+        {
+            t = incident_[last_node];
+            const index_type around = t;
+            do
+            {
+                const int k = slot(t, last_node);
+                vertices_[3 * t + k] = v;
+                t = neighbors_[3 * t + (k + 1) % 3];
+            } while (t != around);
+            x_.set(v, x_[last_node]);
+            y_.set(v, y_[last_node]);
+            incident_[v] = incident_[last_node];
+            std::replace(constraint_nodes_.begin(), constraint_nodes_.end(), last_node, v);
+        }
+        x_.pop_back();
+        y_.pop_back();
+        incident_.pop_back();
+
+        // The last triangles fill the two free slots, the higher one first
+        std::vector<index_type> free_slots(star.begin() + static_cast<std::ptrdiff_t>(count), star.end());
+        std::sort(free_slots.begin(), free_slots.end(), std::greater<index_type>());
+        for (const index_type f : free_slots)
+        {
+            const index_type s = triangle_count() - 1;
+            if (f != s)
+            {
+                move_triangle(s, f);
+                std::replace(written.begin(), written.end(), s, f);
+                written.push_back(f);
+            }
+            vertices_.resize(vertices_.size() - 3);
+            neighbors_.resize(neighbors_.size() - 3);
+            constraints_.pop_back();
+        }
+        if (last_ >= triangle_count())
+        {
+            last_ = written.front();
+        }
+
+        for (const index_type s : written)
+        {
+            if (s < triangle_count())
+            {
+                *changed = s;
+                ++changed;
+            }
+        }
+        return changed;
+    }
+
+    // TRIPACK ADDCST: forces the arcs of the closed curve nodes[0], ..., nodes[n-1], nodes[0]
+    // into the triangulation. The curves must not cross each other or pass through other nodes. A
+    // curve of positive area, counterclockwise, bounds a region, such as a breakline around it; one of
+    // negative area, clockwise, bounds a hole, whose triangles are marked by in_hole.
+    template <typename RAIter>
+    void add_constraint (RAIter nodes_begin, RAIter nodes_end)
+    {
+        const index_type first = constraint_count();
+        append_constraint(nodes_begin, nodes_end);
+        insert_constraints(first);
+    }
+
+    template <typename RAContainer>
+    void add_constraint (const RAContainer& nodes)
+    {
+        add_constraint(std::cbegin(nodes), std::cend(nodes));
+    }
+
+    // add_constraint for each curve of curves, a container of containers of nodes. The orientations of
+    // all of the curves are found first, in one pass over their nodes, and the holes are marked once.
+    template <typename RAContainer>
+    void add_constraints (const RAContainer& curves)
+    {
+        const index_type first = constraint_count();
+        try
+        {
+            for (const auto& curve : curves)
+            {
+                append_constraint(std::cbegin(curve), std::cend(curve));
+            }
+        }
+        catch (...)
+        {
+            constraint_nodes_.resize(constraint_offsets_[first]);
+            constraint_offsets_.resize(first + 1);
+            throw;
+        }
+        insert_constraints(first);
+    }
+
+    // TRIPACK TRFIND: returns a triangle containing (x, y), walking from the triangle start.
+    // The triangle is a ghost triangle if and only if (x, y) lies outside of the convex hull,
+    // in which case (x, y) lies strictly on the outer side of its boundary edge.
+    index_type locate (Real x, Real y, index_type start) const
+    {
+        const statistics_scope scope(stats_);
+        return find(x, y, start);
+    }
+
+    index_type locate (Real x, Real y) const
+    {
+        return locate(x, y, last_);
+    }
+
+    // Number of nodes
+    index_type size () const
+    {
+        return static_cast<index_type>(x_.size());
+    }
+
+    // Number of triangles, including the ghost triangles
+    index_type triangle_count () const
+    {
+        return static_cast<index_type>(vertices_.size() / 3);
+    }
+
+    bool is_ghost (index_type t) const
+    {
+        return vertices_[3 * t + 2] == npos;
+    }
+
+    index_type vertex (index_type t, int i) const
+    {
+        return vertices_[3 * t + i];
+    }
+
+    index_type neighbor (index_type t, int i) const
+    {
+        return neighbors_[3 * t + i];
+    }
+
+    // True if the edge opposite vertex(t, i) is an arc of a constraint curve
+    bool is_constrained (index_type t, int i) const
+    {
+        return (constraints_[t] >> i) & 1u;
+    }
+
+    Real x (index_type v) const
+    {
+        return x_[v];
+    }
+
+    Real y (index_type v) const
+    {
+        return y_[v];
+    }
+
+    // The flat arrays, for the kernels that walk them directly: the coordinates of the nodes, and the
+    // three vertices and three neighbors of each triangle
+    const Real* x_data () const
+    {
+        return x_.data();
+    }
+
+    const Real* y_data () const
+    {
+        return y_.data();
+    }
+
+    const index_type* vertex_data () const
+    {
+        return vertices_.data();
+    }
+
+    const index_type* neighbor_data () const
+    {
+        return neighbors_.data();
+    }
+
+    // A triangle with node v as one of its vertices
+    index_type incident_triangle (index_type v) const
+    {
+        return incident_[v];
+    }
+
+    // Writes the neighbors of node v in counterclockwise order (the TRIPACK adjacency list).
+    // For a node on the convex hull the list runs from one boundary neighbor to the other.
+    template <typename OutputIter>
+    OutputIter neighbors (index_type v, OutputIter out) const
+    {
+        const index_type start = incident_[v];
+
+        // Begin right after the ghost vertex, if v is on the hull
+        index_type t = start;
+        do
+        {
+            const int k = slot(t, v);
+            if (vertices_[3 * t + (k + 1) % 3] == npos)
+            {
+                break;
+            }
+            t = neighbors_[3 * t + (k + 1) % 3];
+        } while (t != start);
+
+        const index_type first = t;
+        do
+        {
+            const int k = slot(t, v);
+            const index_type u = vertices_[3 * t + (k + 1) % 3];
+            if (u != npos)
+            {
+                *out = u;
+                ++out;
+            }
+            t = neighbors_[3 * t + (k + 1) % 3];
+        } while (t != first);
+
+        return out;
+    }
+
+    // Writes the triangles with node v as a vertex, including the ghost ones, in counterclockwise order
+    template <typename OutputIter>
+    OutputIter incident_triangles (index_type v, OutputIter out) const
+    {
+        const index_type start = incident_[v];
+        index_type t = start;
+        do
+        {
+            *out = t;
+            ++out;
+            t = neighbors_[3 * t + (slot(t, v) + 1) % 3];
+        } while (t != start);
+
+        return out;
+    }
+
+    index_type constraint_count () const
+    {
+        return static_cast<index_type>(constraint_offsets_.size() - 1);
+    }
+
+    // The signed area bounded by constraint curve k, negative for a hole
+    predicate_type constraint_area (index_type k) const
+    {
+        return constraint_areas_[k];
+    }
+
+    // True if triangle t lies inside of a hole: a clockwise constraint curve, and no counterclockwise
+    // curve inside of that
+    bool in_hole (index_type t) const
+    {
+        return (constraints_[t] >> 3) & 1u;
+    }
+
+    // The counters since the construction or the last reset; all zero under no_statistics
+    triangulation_statistics statistics () const
+    {
+        return stats_.snapshot();
+    }
+
+    void reset_statistics ()
+    {
+        stats_.reset();
+    }
+
+    std::size_t bytes () const
+    {
+        return (x_.capacity() + y_.capacity()) * sizeof(Real) +
+               (vertices_.capacity() + neighbors_.capacity() + incident_.capacity() +
+                constraint_nodes_.capacity() + constraint_offsets_.capacity() + stack_.capacity()) * sizeof(index_type) +
+               constraint_areas_.capacity() * sizeof(predicate_type) + constraints_.capacity() + sizeof(*this);
+    }
+
+private:
+    using statistics_scope = typename statistics_recorder<Statistics>::scope;
+
+    // legalize rarely swaps more than a few dozen arcs in a row, so its stack does not grow during the
+    // construction
+    static constexpr std::size_t stack_reserve = 256;
+
+    explicit triangulation (const Allocator& alloc)
+        : x_(alloc), y_(alloc), vertices_(alloc), neighbors_(alloc), constraints_(alloc), incident_(alloc),
+          constraint_nodes_(alloc), constraint_offsets_(1, 0, alloc), constraint_areas_(alloc), stack_(alloc)
+    {}
+
+    // locate without counting the exact predicates, which the public operations count once
+    index_type find (Real x, Real y, index_type start) const
+    {
+        index_type steps = 0;
+        index_type t = straight_walk<predicate_type, Statistics>(x_.data(), y_.data(), vertices_.data(), neighbors_.data(),
+                                                     triangle_count(), x, y, start < triangle_count() ? start : last_, &steps);
+        const bool exhaustive = t == npos;
+        if (exhaustive)
+        {
+            t = exhaustive_search<predicate_type, Statistics>(x_.data(), y_.data(), vertices_.data(), triangle_count(), x, y);
+        }
+        stats_.location(steps, exhaustive);
+        return t;
+    }
+
+    int slot (index_type t, index_type v) const
+    {
+        return vertices_[3 * t] == v ? 0 : vertices_[3 * t + 1] == v ? 1 : 2;
+    }
+
+    index_type new_triangle ()
+    {
+        vertices_.resize(vertices_.size() + 3);
+        neighbors_.resize(neighbors_.size() + 3);
+        constraints_.push_back(0);
+        return triangle_count() - 1;
+    }
+
+    // Writes the counterclockwise triangle (a, b, c) with neighbors na, nb, nc across the edges opposite
+    // a, b, c and constraint bits ca, cb, cc, rotated so that the ghost vertex, if any, is in slot 2.
+    void set_triangle (index_type t, index_type a, index_type b, index_type c,
+                       index_type na, index_type nb, index_type nc,
+                       bool ca = false, bool cb = false, bool cc = false)
+    {
+        if (a == npos)
+        {
+            set_triangle(t, b, c, a, nb, nc, na, cb, cc, ca);
+            return;
+        }
+        if (b == npos)
+        {
+            set_triangle(t, c, a, b, nc, na, nb, cc, ca, cb);
+            return;
+        }
+
+        vertices_[3 * t] = a;
+        vertices_[3 * t + 1] = b;
+        vertices_[3 * t + 2] = c;
+        neighbors_[3 * t] = na;
+        neighbors_[3 * t + 1] = nb;
+        neighbors_[3 * t + 2] = nc;
+        constraints_[t] = static_cast<unsigned char>(ca | (cb << 1) | (cc << 2));
+
+        incident_[a] = t;
+        incident_[b] = t;
+        if (c != npos)
+        {
+            incident_[c] = t;
+        }
+        last_ = t;
+    }
+
+    // Moves triangle s to the slot t, which is unused
+    void move_triangle (index_type s, index_type t)
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            vertices_[3 * t + i] = vertices_[3 * s + i];
+            neighbors_[3 * t + i] = neighbors_[3 * s + i];
+            replace_neighbor(neighbors_[3 * t + i], s, t);
+            const index_type w = vertices_[3 * t + i];
+            if (w != npos && incident_[w] == s)
+            {
+                incident_[w] = t;
+            }
+        }
+        constraints_[t] = constraints_[s];
+        if (last_ == s)
+        {
+            last_ = t;
+        }
+    }
+
+    void replace_neighbor (index_type t, index_type old_neighbor, index_type new_neighbor)
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            if (neighbors_[3 * t + i] == old_neighbor)
+            {
+                neighbors_[3 * t + i] = new_neighbor;
+                return;
+            }
+        }
+    }
+
+    predicate_type orient (index_type a, index_type b, index_type c) const
+    {
+        return robust_orient2d<predicate_type, Statistics>(x_[a], y_[a], x_[b], y_[b], x_[c], y_[c]);
+    }
+
+    template <typename RAIter>
+    void assign (RAIter x_begin, RAIter x_end, RAIter y_begin, RAIter y_end)
+    {
+        check_nodes(static_cast<std::size_t>(std::distance(x_begin, x_end)), static_cast<std::size_t>(std::distance(y_begin, y_end)));
+        const auto n = static_cast<index_type>(std::distance(x_begin, x_end));
+        x_.reserve(n);
+        y_.reserve(n);
+        for (; x_begin != x_end; ++x_begin, ++y_begin)
+        {
+            x_.push_back(static_cast<Real>(*x_begin));
+            y_.push_back(static_cast<Real>(*y_begin));
+        }
+        reserve_triangles(n);
+    }
+
+    void assign (node_array<Real, Allocator>&& x, node_array<Real, Allocator>&& y)
+    {
+        check_nodes(x.size(), y.size());
+        x_ = std::move(x);
+        y_ = std::move(y);
+        reserve_triangles(size());
+    }
+
+    static void check_nodes (std::size_t abscissas, std::size_t ordinates)
+    {
+        check_capacity(abscissas);
+        if (abscissas != ordinates)
+        {
+            throw std::domain_error("There must be the same number of abscissas and ordinates.");
+        }
+        if (abscissas < 3)
+        {
+            throw std::domain_error("At least three nodes are required.");
+        }
+    }
+
+    void reserve_triangles (index_type n)
+    {
+        incident_.assign(n, npos);
+
+        // Euler: 2n - 2 triangles including the ghost triangles
+        vertices_.reserve(6 * n);
+        neighbors_.reserve(6 * n);
+        constraints_.reserve(2 * n);
+        stack_.reserve(stack_reserve);
+    }
+
+    // n nodes have about 2n triangles, whose 6n entries must stay below npos
+    static void check_capacity (std::size_t n)
+    {
+        if (n > (static_cast<std::size_t>((std::numeric_limits<index_type>::max)()) - 64) / 6)
+        {
+            std::ostringstream oss;
+            oss << "The triangles of " << n << " nodes cannot be numbered with a " << 8 * sizeof(index_type) << "-bit index type.";
+            throw std::domain_error(oss.str());
+        }
+    }
+
+    std::vector<index_type> all_nodes () const
+    {
+        std::vector<index_type> nodes(size());
+        for (index_type i = 0; i < size(); ++i)
+        {
+            nodes[i] = i;
+        }
+        return nodes;
+    }
+
+    // Triangulates the given nodes; the others are left out
+    void build (const std::vector<index_type>& nodes)
+    {
+        phase_timer<Statistics> ordering(stats_.seconds(&triangulation_statistics::ordering_seconds));
+        const std::vector<index_type> order = brio_order<Real, index_type>(x_, y_, nodes);
+        ordering.stop();
+
+        const phase_timer<Statistics> insertion(stats_.seconds(&triangulation_statistics::insertion_seconds));
+        const index_type n = static_cast<index_type>(order.size());
+
+        // The first node, the first node distinct from it, and the first node not collinear with both
+        const index_type i0 = order[0];
+        index_type k1 = 1;
+        while (k1 < n && x_[order[k1]] == x_[i0] && y_[order[k1]] == y_[i0])
+        {
+            ++k1;
+        }
+        index_type k2 = k1 + 1;
+        while (k2 < n && orient(i0, order[k1], order[k2]) == 0)
+        {
+            ++k2;
+        }
+        if (k2 >= n)
+        {
+            throw std::domain_error("All nodes are collinear.");
+        }
+
+        const index_type i1 = order[k1];
+        const index_type i2 = order[k2];
+        if (orient(i0, i1, i2) > 0)
+        {
+            initialize(i0, i1, i2);
+        }
+        else
+        {
+            initialize(i0, i2, i1);
+        }
+
+        for (index_type k = 1; k < n; ++k)
+        {
+            if (k != k1 && k != k2)
+            {
+                insert(order[k], last_);
+            }
+        }
+    }
+
+    // The temporary triangulation of a cell, whose counters are added to those of the whole
+    using cell_triangulation = triangulation<Real, Index, std::allocator<Real>, Statistics>;
+
+    // A cell of build_partitioned: the nodes order[begin], ..., order[end - 1], which lie in the closed
+    // rectangle [x_low, x_high] by [y_low, y_high] while all other nodes lie outside of its interior
+    struct cell
+    {
+        index_type begin;
+        index_type end;
+        Real x_low;
+        Real x_high;
+        Real y_low;
+        Real y_high;
+
+        // The final triangles, whose circumdisks lie inside of the rectangle: their counterclockwise
+        // vertices, and for each edge the final triangle across it or npos if there is none
+        std::vector<index_type> vertices;
+        std::vector<index_type> neighbors;
+
+        // The vertices of the other triangles
+        std::vector<index_type> seam;
+    };
+
+    template <typename Executor>
+    void build_partitioned (Executor& executor)
+    {
+        // Large enough that the seams hold a small fraction of the nodes, and fixed so that the result
+        // does not depend on the number of threads
+        constexpr index_type cell_size = static_cast<index_type>(1) << 16;
+        const index_type n = size();
+        const auto columns = static_cast<index_type>(std::sqrt(static_cast<double>(n / cell_size)));
+        if (columns < 2)
+        {
+            build(all_nodes());
+            return;
+        }
+        const index_type rows = n / cell_size / columns;
+
+        // Columns of nodes by abscissa, each split into cells by ordinate, with ties broken by the
+        // other coordinate and then the index
+        phase_timer<Statistics> ordering(stats_.seconds(&triangulation_statistics::ordering_seconds));
+        std::vector<index_type> order = all_nodes();
+        std::sort(order.begin(), order.end(), [this](index_type a, index_type b)
+        {
+            return x_[a] < x_[b] || (x_[a] == x_[b] && (y_[a] < y_[b] || (y_[a] == y_[b] && a < b)));
+        });
+
+        const Real lowest = std::numeric_limits<Real>::lowest();
+        const Real highest = (std::numeric_limits<Real>::max)();
+        std::vector<cell> cells(columns * rows);
+        Real x_low = lowest;
+        for (index_type c = 0; c < columns; ++c)
+        {
+            const index_type first = n / columns * c + (std::min)(c, n % columns);
+            const index_type last = first + n / columns + (c < n % columns ? 1 : 0);
+            const Real x_high = c + 1 < columns ? x_[order[last]] : highest;
+            std::sort(order.begin() + first, order.begin() + last, [this](index_type a, index_type b)
+            {
+                return y_[a] < y_[b] || (y_[a] == y_[b] && (x_[a] < x_[b] || (x_[a] == x_[b] && a < b)));
+            });
+
+            const index_type m = last - first;
+            for (index_type r = 0; r < rows; ++r)
+            {
+                cell& current = cells[c * rows + r];
+                current.begin = first + m / rows * r + (std::min)(r, m % rows);
+                current.end = current.begin + m / rows + (r < m % rows ? 1 : 0);
+                current.x_low = x_low;
+                current.x_high = x_high;
+                current.y_low = r > 0 ? y_[order[current.begin - 1]] : lowest;
+                current.y_high = r + 1 < rows ? y_[order[current.end]] : highest;
+            }
+            x_low = x_high;
+        }
+
+        ordering.stop();
+
+        phase_timer<Statistics> cell_phase(stats_.seconds(&triangulation_statistics::cell_seconds));
+        executor(static_cast<std::size_t>(cells.size()), [this, &order, &cells](std::size_t k)
+        {
+            triangulate_cell(order, cells[k]);
+        });
+        cell_phase.stop();
+
+        std::vector<index_type> seam;
+        index_type final_count = 0;
+        for (const cell& current : cells)
+        {
+            seam.insert(seam.end(), current.seam.begin(), current.seam.end());
+            final_count += static_cast<index_type>(current.vertices.size() / 3);
+        }
+        if (final_count == 0)
+        {
+            build(all_nodes());
+            return;
+        }
+
+        // The seam nodes include the convex hull of all nodes. Each edge bounding the final triangles
+        // of a cell is a Delaunay edge between seam nodes, so forcing it changes nothing once the
+        // nodes are in general position; the triangles on its side that belong to the cell are
+        // then replaced by the final ones. The seam nodes are timed with the ordering and the insertions.
+        build(seam);
+        const phase_timer<Statistics> stitching(stats_.seconds(&triangulation_statistics::stitching_seconds));
+        for (const cell& current : cells)
+        {
+            for (index_type j = 0; j < current.neighbors.size(); ++j)
+            {
+                if (current.neighbors[j] == npos)
+                {
+                    const index_type f = j - j % 3;
+                    insert_constraint_arc(current.vertices[f + (j + 1) % 3], current.vertices[f + (j + 2) % 3]);
+                }
+            }
+        }
+
+        // The seam triangles on the side of the final triangles, and for each of their edges on the
+        // boundary, the final triangle across it
+        std::vector<index_type> boundary;
+        std::vector<index_type> inside(3 * triangle_count(), npos);
+        std::vector<unsigned char> removed(triangle_count(), 0);
+        std::vector<index_type> free_slots;
+        const index_type seam_count = triangle_count();
+        auto slot_of = [&free_slots, seam_count](index_type g)
+        {
+            return g < free_slots.size() ? free_slots[g] : seam_count + (g - free_slots.size());
+        };
+
+        for (const cell& current : cells)
+        {
+            for (index_type j = 0; j < current.neighbors.size(); ++j)
+            {
+                if (current.neighbors[j] == npos)
+                {
+                    const index_type f = j - j % 3;
+                    index_type t = 0;
+                    int i = 0;
+                    find_edge(current.vertices[f + (j + 1) % 3], current.vertices[f + (j + 2) % 3], t, i);
+                    boundary.push_back(3 * t + static_cast<index_type>(i));
+                    if (!removed[t])
+                    {
+                        removed[t] = 1;
+                        stack_.push_back(t);
+                    }
+                }
+            }
+        }
+        while (!stack_.empty())
+        {
+            const index_type t = stack_.back();
+            stack_.pop_back();
+            for (int i = 0; i < 3; ++i)
+            {
+                const index_type u = neighbors_[3 * t + i];
+                if (!is_constrained(t, i) && !removed[u])
+                {
+                    removed[u] = 1;
+                    stack_.push_back(u);
+                }
+            }
+        }
+        for (index_type t = 0; t < seam_count; ++t)
+        {
+            if (removed[t])
+            {
+                free_slots.push_back(t);
+            }
+        }
+
+        index_type g = 0;
+        index_type e = 0;
+        for (const cell& current : cells)
+        {
+            for (index_type j = 0; j < current.neighbors.size(); ++j)
+            {
+                if (current.neighbors[j] == npos)
+                {
+                    inside[boundary[e++]] = slot_of(g + j / 3);
+                }
+            }
+            g += static_cast<index_type>(current.vertices.size() / 3);
+        }
+
+        // Across each boundary edge: a final triangle of another cell, or a seam triangle to relink
+        std::vector<index_type> outside(boundary.size());
+        std::vector<index_type> relink;
+        for (e = 0; e < boundary.size(); ++e)
+        {
+            const index_type t = boundary[e] / 3;
+            const index_type a = vertices_[3 * t + (boundary[e] + 1) % 3];
+            const index_type b = vertices_[3 * t + (boundary[e] + 2) % 3];
+            const index_type u = neighbors_[boundary[e]];
+            const index_type k = 3 * u + static_cast<index_type>(3 - slot(u, a) - slot(u, b));
+            outside[e] = removed[u] ? inside[k] : u;
+            if (!removed[u])
+            {
+                relink.push_back(k);
+                relink.push_back(inside[boundary[e]]);
+            }
+        }
+
+        while (triangle_count() < seam_count + final_count - (std::min)(final_count, static_cast<index_type>(free_slots.size())))
+        {
+            new_triangle();
+        }
+
+        g = 0;
+        e = 0;
+        for (const cell& current : cells)
+        {
+            const auto& v = current.vertices;
+            index_type adjacent[3];
+            for (index_type f = 0; f < v.size(); f += 3)
+            {
+                for (int i = 0; i < 3; ++i)
+                {
+                    const index_type u = current.neighbors[f + i];
+                    adjacent[i] = u != npos ? slot_of(g + u) : outside[e++];
+                }
+                set_triangle(slot_of(g + f / 3), v[f], v[f + 1], v[f + 2], adjacent[0], adjacent[1], adjacent[2]);
+            }
+            g += static_cast<index_type>(v.size() / 3);
+        }
+        for (index_type k = 0; k < relink.size(); k += 2)
+        {
+            neighbors_[relink[k]] = relink[k + 1];
+            constraints_[relink[k] / 3] &= static_cast<unsigned char>(~(1u << (relink[k] % 3)));
+        }
+    }
+
+    // Triangulates the nodes of a cell and sorts its triangles into final ones and seam ones. A cell
+    // whose nodes are collinear or coincident is left to the seam.
+    void triangulate_cell (const std::vector<index_type>& order, cell& current) const
+    {
+        const index_type m = current.end - current.begin;
+        std::vector<Real> xs(m);
+        std::vector<Real> ys(m);
+        for (index_type i = 0; i < m; ++i)
+        {
+            xs[i] = x_[order[current.begin + i]];
+            ys[i] = y_[order[current.begin + i]];
+        }
+
+        std::vector<unsigned char> on_seam(m, 1);
+        try
+        {
+            const cell_triangulation local(xs, ys);
+            stats_.merge(local.statistics());
+            std::fill(on_seam.begin(), on_seam.end(), 0);
+
+            std::vector<index_type> final_index(local.triangle_count(), npos);
+            index_type count = 0;
+            for (index_type t = 0; t < local.triangle_count(); ++t)
+            {
+                if (!local.is_ghost(t) && is_final(local, t, current))
+                {
+                    final_index[t] = count++;
+                    continue;
+                }
+                for (int i = 0; i < 3; ++i)
+                {
+                    if (local.vertex(t, i) != npos)
+                    {
+                        on_seam[local.vertex(t, i)] = 1;
+                    }
+                }
+            }
+
+            current.vertices.reserve(3 * count);
+            current.neighbors.reserve(3 * count);
+            for (index_type t = 0; t < local.triangle_count(); ++t)
+            {
+                if (final_index[t] != npos)
+                {
+                    for (int i = 0; i < 3; ++i)
+                    {
+                        current.vertices.push_back(order[current.begin + local.vertex(t, i)]);
+                        current.neighbors.push_back(final_index[local.neighbor(t, i)]);
+                    }
+                }
+            }
+        }
+        catch (const std::domain_error&)
+        {
+            current.vertices.clear();
+            current.neighbors.clear();
+        }
+
+        for (index_type i = 0; i < m; ++i)
+        {
+            if (on_seam[i])
+            {
+                current.seam.push_back(order[current.begin + i]);
+            }
+        }
+    }
+
+    // True if the circumdisk of triangle t lies inside of the rectangle of the cell, allowing for the
+    // rounding errors of its center and radius; no node of another cell is then in it.
+    static bool is_final (const cell_triangulation& local, index_type t, const cell& current)
+    {
+        Real ux = 0;
+        Real uy = 0;
+        Real reach = 0;
+        if (!bounding_circumdisk(local.x(local.vertex(t, 0)), local.y(local.vertex(t, 0)), local.x(local.vertex(t, 1)),
+                                 local.y(local.vertex(t, 1)), local.x(local.vertex(t, 2)), local.y(local.vertex(t, 2)), ux, uy, reach))
+        {
+            return false;
+        }
+
+        return ux - reach > current.x_low && ux + reach < current.x_high &&
+               uy - reach > current.y_low && uy + reach < current.y_high;
+    }
+
+    // The counterclockwise triangle (a, b, c) and the three ghost triangles around it
+    void initialize (index_type a, index_type b, index_type c)
+    {
+        const index_type t = new_triangle();
+        const index_type g_ab = new_triangle();
+        const index_type g_bc = new_triangle();
+        const index_type g_ca = new_triangle();
+
+        set_triangle(g_ab, b, a, npos, g_ca, g_bc, t);
+        set_triangle(g_bc, c, b, npos, g_ab, g_ca, t);
+        set_triangle(g_ca, a, c, npos, g_bc, g_ab, t);
+        set_triangle(t, a, b, c, g_bc, g_ca, g_ab);
+    }
+
+    // Inserts node v, which is not yet a vertex, walking from the triangle start
+    void insert (index_type v, index_type start)
+    {
+        stats_.insertion();
+        const Real px = x_[v];
+        const Real py = y_[v];
+        const index_type t = find(px, py, start);
+
+        if (is_ghost(t))
+        {
+            split_triangle(t, v);
+            return;
+        }
+
+        const auto w = &vertices_[3 * t];
+        int on_edge = -1;
+        for (int i = 0; i < 3; ++i)
+        {
+            const index_type a = w[(i + 1) % 3];
+            const index_type b = w[(i + 2) % 3];
+            if (robust_orient2d<predicate_type, Statistics>(x_[a], y_[a], x_[b], y_[b], px, py) == 0)
+            {
+                if (on_edge >= 0)
+                {
+                    // On two edges: v coincides with the vertex they share
+                    const index_type u = w[3 - on_edge - i];
+                    std::ostringstream oss;
+                    oss.precision(std::numeric_limits<Real>::digits10 + 3);
+                    oss << "Nodes " << u << " and " << v << " coincide at (" << px << ", " << py << ").";
+                    throw std::domain_error(oss.str());
+                }
+                on_edge = i;
+            }
+        }
+
+        if (on_edge < 0)
+        {
+            split_triangle(t, v);
+        }
+        else
+        {
+            split_edge(t, on_edge, v);
+        }
+    }
+
+    // Splits triangle t into three triangles about node v, then restores the Delaunay property
+    void split_triangle (index_type t, index_type v)
+    {
+        const auto w = &vertices_[3 * t];
+        const index_type a = w[0];
+        const index_type b = w[1];
+        const index_type c = w[2];
+        const index_type na = neighbors_[3 * t];
+        const index_type nb = neighbors_[3 * t + 1];
+        const index_type nc = neighbors_[3 * t + 2];
+        const bool ca = is_constrained(t, 0);
+        const bool cb = is_constrained(t, 1);
+        const bool cc = is_constrained(t, 2);
+
+        const index_type t1 = new_triangle();
+        const index_type t2 = new_triangle();
+
+        set_triangle(t, a, b, v, t1, t2, nc, false, false, cc);
+        set_triangle(t1, b, c, v, t2, t, na, false, false, ca);
+        set_triangle(t2, c, a, v, t, t1, nb, false, false, cb);
+        replace_neighbor(na, t, t1);
+        replace_neighbor(nb, t, t2);
+
+        index_type stack[] = {t, t1, t2};
+        legalize(v, stack, stack + 3);
+    }
+
+    // Splits the edge opposite vertex(t, i), and the triangle across it, into four triangles about node v
+    void split_edge (index_type t, int i, index_type v)
+    {
+        const index_type c = vertices_[3 * t + i];
+        const index_type a = vertices_[3 * t + (i + 1) % 3];
+        const index_type b = vertices_[3 * t + (i + 2) % 3];
+        const index_type nta = neighbors_[3 * t + (i + 1) % 3];
+        const index_type ntb = neighbors_[3 * t + (i + 2) % 3];
+        const bool cta = is_constrained(t, (i + 1) % 3);
+        const bool ctb = is_constrained(t, (i + 2) % 3);
+        const bool cab = is_constrained(t, i);
+
+        const index_type u = neighbors_[3 * t + i];
+        const int j = 3 - slot(u, a) - slot(u, b);
+        const index_type d = vertices_[3 * u + j];
+        const index_type nua = neighbors_[3 * u + slot(u, a)];
+        const index_type nub = neighbors_[3 * u + slot(u, b)];
+        const bool cua = is_constrained(u, slot(u, a));
+        const bool cub = is_constrained(u, slot(u, b));
+
+        const index_type t1 = new_triangle();
+        const index_type u1 = new_triangle();
+
+        set_triangle(t, a, v, c, t1, ntb, u1, false, ctb, cab);
+        set_triangle(t1, v, b, c, nta, t, u, cta, false, cab);
+        set_triangle(u, b, v, d, u1, nua, t1, false, cua, cab);
+        set_triangle(u1, v, a, d, nub, u, t, cub, false, cab);
+        replace_neighbor(nta, t, t1);
+        replace_neighbor(nub, u, u1);
+
+        index_type stack[] = {t, t1, u, u1};
+        legalize(v, stack, stack + 4);
+    }
+
+    // True if the edge opposite vertex(t, i) is not locally Delaunay and may be swapped
+    bool is_illegal (index_type t, int i) const
+    {
+        if (is_constrained(t, i))
+        {
+            return false;
+        }
+
+        const index_type p = vertices_[3 * t + i];
+        const index_type x = vertices_[3 * t + (i + 1) % 3];
+        const index_type y = vertices_[3 * t + (i + 2) % 3];
+        const index_type u = neighbors_[3 * t + i];
+        const index_type q = vertices_[3 * u + 3 - slot(u, x) - slot(u, y)];
+
+        // A boundary edge is never swapped
+        if (p == npos || q == npos)
+        {
+            return false;
+        }
+
+        // An edge to the ghost vertex is swapped if the boundary is not convex at its other end
+        if (x == npos)
+        {
+            return orient(q, y, p) > 0;
+        }
+        if (y == npos)
+        {
+            return orient(x, q, p) > 0;
+        }
+
+        return robust_incircle<predicate_type, Statistics>(x_[x], y_[x], x_[y], y_[y], x_[p], y_[p], x_[q], y_[q]) > 0;
+    }
+
+    // Swaps the edge opposite vertex(t, i). Afterwards t and the triangle across the edge
+    // share the other diagonal of their quadrilateral, and vertex(t, i) is a vertex of both.
+    index_type flip (index_type t, int i)
+    {
+        stats_.flip();
+        const index_type p = vertices_[3 * t + i];
+        const index_type x = vertices_[3 * t + (i + 1) % 3];
+        const index_type y = vertices_[3 * t + (i + 2) % 3];
+        const index_type n_x = neighbors_[3 * t + (i + 1) % 3];
+        const index_type n_y = neighbors_[3 * t + (i + 2) % 3];
+        const bool c_x = is_constrained(t, (i + 1) % 3);
+        const bool c_y = is_constrained(t, (i + 2) % 3);
+
+        const index_type u = neighbors_[3 * t + i];
+        const int ux = slot(u, x);
+        const int uy = slot(u, y);
+        const index_type q = vertices_[3 * u + 3 - ux - uy];
+        const index_type m_x = neighbors_[3 * u + ux];
+        const index_type m_y = neighbors_[3 * u + uy];
+        const bool d_x = is_constrained(u, ux);
+        const bool d_y = is_constrained(u, uy);
+
+        set_triangle(t, x, q, p, u, n_y, m_y, false, c_y, d_y);
+        set_triangle(u, q, y, p, n_x, t, m_x, c_x, false, d_x);
+        replace_neighbor(n_x, t, u);
+        replace_neighbor(m_y, u, t);
+
+        return u;
+    }
+
+    // Lawson's swapping about the newly inserted node v: the triangles on the stack all contain v
+    void legalize (index_type v, index_type* stack_begin, index_type* stack_end)
+    {
+        stack_.assign(stack_begin, stack_end);
+        while (!stack_.empty())
+        {
+            const index_type t = stack_.back();
+            stack_.pop_back();
+
+            const int i = slot(t, v);
+            if (is_illegal(t, i))
+            {
+                const index_type u = flip(t, i);
+                stack_.push_back(t);
+                stack_.push_back(u);
+            }
+        }
+    }
+
+    // Finds the triangle t in which node b follows node a, so that edge (a, b) is opposite vertex(t, i)
+    bool find_edge (index_type a, index_type b, index_type& t, int& i) const
+    {
+        const index_type start = incident_[a];
+        t = start;
+        do
+        {
+            const int k = slot(t, a);
+            if (vertices_[3 * t + (k + 1) % 3] == b)
+            {
+                i = (k + 2) % 3;
+                return true;
+            }
+            t = neighbors_[3 * t + (k + 1) % 3];
+        } while (t != start);
+
+        return false;
+    }
+
+    void set_constrained (index_type a, index_type b)
+    {
+        index_type t = 0;
+        int i = 0;
+        find_edge(a, b, t, i);
+        constraints_[t] |= static_cast<unsigned char>(1u << i);
+        const index_type u = neighbors_[3 * t + i];
+        constraints_[u] |= static_cast<unsigned char>(1u << (3 - slot(u, a) - slot(u, b)));
+    }
+
+    [[noreturn]] void throw_on_node (index_type a, index_type b, index_type v) const
+    {
+        std::ostringstream oss;
+        oss << "The constraint arc from node " << a << " to node " << b << " passes through node " << v << ".";
+        throw std::domain_error(oss.str());
+    }
+
+    [[noreturn]] void throw_crossing (index_type a, index_type b, index_type u, index_type w) const
+    {
+        std::ostringstream oss;
+        oss << "The constraint arc from node " << a << " to node " << b
+            << " crosses the constraint arc from node " << u << " to node " << w << ".";
+        throw std::domain_error(oss.str());
+    }
+
+    // Checks the nodes of a curve and appends it to the curves
+    template <typename RAIter>
+    void append_constraint (RAIter nodes_begin, RAIter nodes_end)
+    {
+        if (std::distance(nodes_begin, nodes_end) < 3)
+        {
+            throw std::domain_error("A constraint curve must have at least three nodes.");
+        }
+        for (auto it = nodes_begin; it != nodes_end; ++it)
+        {
+            const auto node = static_cast<index_type>(*it);
+            if (node >= size())
+            {
+                std::ostringstream oss;
+                oss << "Constraint node " << node << " is not a node of the triangulation, which has " << size() << " nodes.";
+                throw std::domain_error(oss.str());
+            }
+        }
+        for (auto it = nodes_begin; it != nodes_end; ++it)
+        {
+            constraint_nodes_.push_back(static_cast<index_type>(*it));
+        }
+        constraint_offsets_.push_back(static_cast<index_type>(constraint_nodes_.size()));
+    }
+
+    // Finds the orientations of the curves from first on, by the lanes of polygonal_area with
+    // compensated sums, so that the sign of their area is right however thin they are, then inserts
+    // their arcs and marks the holes
+    void insert_constraints (index_type first)
+    {
+        const statistics_scope scope(stats_);
+        const phase_timer<Statistics> timer(stats_.seconds(&triangulation_statistics::constraint_seconds));
+        for (index_type k = first; k < constraint_count(); ++k)
+        {
+            const index_type* nodes = constraint_nodes_.data() + constraint_offsets_[k];
+            const auto n = static_cast<std::size_t>(constraint_offsets_[k + 1] - constraint_offsets_[k]);
+            const predicate_type area = -polygonal_area_sum<predicate_type>(x_.data(), y_.data(), node_list<const index_type*> {nodes}, n,
+                                                                            compensated_summation()) / 2;
+            constraint_areas_.push_back(area);
+            holes_ = holes_ || area < 0;
+        }
+        for (index_type k = first; k < constraint_count(); ++k)
+        {
+            const index_type begin = constraint_offsets_[k];
+            const index_type n = constraint_offsets_[k + 1] - begin;
+            for (index_type i = 0; i < n; ++i)
+            {
+                insert_constraint_arc(constraint_nodes_[begin + i], constraint_nodes_[begin + (i + 1) % n]);
+            }
+        }
+        mark_holes();
+    }
+
+    // Marks the triangles inside of the holes, which lie on the right of their arcs, by filling from
+    // those arcs up to the arcs of any curve
+    void mark_holes ()
+    {
+        if (!holes_)
+        {
+            return;
+        }
+
+        for (unsigned char& c : constraints_)
+        {
+            c &= 7u;
+        }
+        std::vector<index_type> stack;
+        for (index_type k = 0; k < constraint_count(); ++k)
+        {
+            if (!(constraint_areas_[k] < 0))
+            {
+                continue;
+            }
+            const index_type begin = constraint_offsets_[k];
+            const index_type n = constraint_offsets_[k + 1] - begin;
+            for (index_type i = 0; i < n; ++i)
+            {
+                index_type t = 0;
+                int j = 0;
+                if (find_edge(constraint_nodes_[begin + (i + 1) % n], constraint_nodes_[begin + i], t, j))
+                {
+                    stack.push_back(t);
+                }
+            }
+        }
+        while (!stack.empty())
+        {
+            const index_type t = stack.back();
+            stack.pop_back();
+            if (in_hole(t) || is_ghost(t))
+            {
+                continue;
+            }
+            constraints_[t] |= 8u;
+            for (int i = 0; i < 3; ++i)
+            {
+                if (!is_constrained(t, i))
+                {
+                    stack.push_back(neighbors_[3 * t + i]);
+                }
+            }
+        }
+    }
+
+    // Marks the triangles of node v after add_node, which lie in one region unless it splits an arc of a
+    // curve, as the triangle across an edge opposite v that is not constrained
+    void mark_star (index_type v)
+    {
+        index_type across = npos;
+        index_type t = incident_[v];
+        const index_type start = t;
+        do
+        {
+            const int k = slot(t, v);
+            if (is_constrained(t, (k + 1) % 3) || is_constrained(t, (k + 2) % 3))
+            {
+                mark_holes();
+                return;
+            }
+            if (across == npos && !is_ghost(t) && !is_constrained(t, k))
+            {
+                across = neighbors_[3 * t + k];
+            }
+            t = neighbors_[3 * t + (k + 1) % 3];
+        } while (t != start);
+        if (across == npos)
+        {
+            mark_holes();
+            return;
+        }
+
+        // Beyond an edge of the hull lies no hole
+        const bool hole = !is_ghost(across) && in_hole(across);
+        do
+        {
+            if (hole && !is_ghost(t))
+            {
+                constraints_[t] |= 8u;
+            }
+            t = neighbors_[3 * t + (slot(t, v) + 1) % 3];
+        } while (t != start);
+    }
+
+    // TRIPACK EDGE, with the cavity retriangulated at once rather than by swapping arcs (Anglada 1997):
+    // the triangles crossed by the segment from node a to node b are removed, and each of the two
+    // polygons on either side of it is filled with its constrained Delaunay triangulation, each of whose
+    // triangles on an edge takes the vertex whose circle through the edge holds no other. The rest of
+    // the triangulation is unchanged, and no arcs are swapped afterwards.
+    void insert_constraint_arc (index_type a, index_type b)
+    {
+        if (a == b)
+        {
+            throw std::domain_error("A constraint arc must join two distinct nodes.");
+        }
+
+        index_type t = incident_[a];
+        const index_type start = t;
+        index_type right = npos;
+        index_type left = npos;
+        do
+        {
+            const int k = slot(t, a);
+            const index_type u = vertices_[3 * t + (k + 1) % 3];
+            const index_type w = vertices_[3 * t + (k + 2) % 3];
+            if (u == b || w == b)
+            {
+                set_constrained(a, b);
+                return;
+            }
+            if (u != npos && w != npos)
+            {
+                const predicate_type ou = orient(a, u, b);
+                const predicate_type ow = orient(a, w, b);
+                for (const index_type r : {u, w})
+                {
+                    if (orient(a, r, b) == 0 && (x_[r] - x_[a]) * (x_[b] - x_[a]) + (y_[r] - y_[a]) * (y_[b] - y_[a]) > 0)
+                    {
+                        throw_on_node(a, b, r);
+                    }
+                }
+                if (ou > 0 && ow < 0)
+                {
+                    right = u;
+                    left = w;
+                    break;
+                }
+            }
+            t = neighbors_[3 * t + (k + 1) % 3];
+        } while (t != start);
+
+        if (right == npos)
+        {
+            throw std::domain_error("A constraint arc does not lie inside of the convex hull.");
+        }
+
+        // Walk along the segment, collecting the triangles it crosses, the vertices on its left and right
+        // in order from a to b, and the triangles across the edges between them
+        struct cavity_edge
+        {
+            index_type outer;
+            index_type side;
+            bool constrained;
+            index_type twin;
+        };
+        auto border = [this](index_type s, index_type r)
+        {
+            const int k = slot(s, r);
+            const index_type u = neighbors_[3 * s + k];
+            const index_type from = vertices_[3 * s + (k + 1) % 3];
+            const index_type to = vertices_[3 * s + (k + 2) % 3];
+            return cavity_edge {u, 3 * u + static_cast<index_type>(3 - slot(u, from) - slot(u, to)), is_constrained(s, k), npos};
+        };
+        std::vector<index_type> cavity {t};
+        std::vector<index_type> upper {a, left};
+        std::vector<index_type> lower {a, right};
+        std::vector<cavity_edge> upper_edges {border(t, right)};
+        std::vector<cavity_edge> lower_edges {border(t, left)};
+        while (true)
+        {
+            const int k = 3 - slot(t, right) - slot(t, left);
+            if (is_constrained(t, k))
+            {
+                throw_crossing(a, b, right, left);
+            }
+
+            t = neighbors_[3 * t + k];
+            cavity.push_back(t);
+            const index_type q = vertices_[3 * t + 3 - slot(t, right) - slot(t, left)];
+            if (q == b)
+            {
+                break;
+            }
+
+            const predicate_type o = orient(a, b, q);
+            if (o == 0)
+            {
+                throw_on_node(a, b, q);
+            }
+            if (o > 0)
+            {
+                left = q;
+                upper.push_back(q);
+                upper_edges.push_back(border(t, right));
+            }
+            else
+            {
+                right = q;
+                lower.push_back(q);
+                lower_edges.push_back(border(t, left));
+            }
+        }
+        upper.push_back(b);
+        upper_edges.push_back(border(t, right));
+        lower.push_back(b);
+        lower_edges.push_back(border(t, left));
+        std::reverse(lower.begin(), lower.end());
+        std::reverse(lower_edges.begin(), lower_edges.end());
+
+        // Both polygons run clockwise from their first node to their last, so that each triangle
+        // (p[i], p[j], p[c]) on the edge from p[i] to p[j] is counterclockwise. The triangles take the
+        // slots of those removed in turn, and each is joined to the triangle it was split from, in its
+        // third slot, and to the triangles across the boundary of the cavity.
+        struct split
+        {
+            std::size_t i;
+            std::size_t j;
+            index_type parent;
+        };
+        std::vector<split> pending;
+        std::vector<index_type> open;
+        std::size_t h = 0;
+        index_type root[2];
+        for (int side = 0; side < 2; ++side)
+        {
+            const std::vector<index_type>& p = side == 0 ? upper : lower;
+            std::vector<cavity_edge>& edges = side == 0 ? upper_edges : lower_edges;
+
+            // Where the segment passes on both sides of a node, the edges to it lie inside of the cavity
+            // and on its boundary twice, once either way, nested as the boundary goes out and back
+            open.clear();
+            for (index_type k = 0; k < edges.size(); ++k)
+            {
+                if (!open.empty() && p[open.back()] == p[k + 1] && p[open.back() + 1] == p[k])
+                {
+                    edges[k].twin = open.back();
+                    edges[open.back()].twin = k;
+                    open.pop_back();
+                }
+                else
+                {
+                    open.push_back(k);
+                }
+            }
+
+            root[side] = cavity[h];
+            pending.push_back({0, p.size() - 1, npos});
+            while (!pending.empty())
+            {
+                const split s = pending.back();
+                pending.pop_back();
+
+                // The circles through p[i] and p[j] on this side are nested, so one pass finds the vertex
+                std::size_t c = s.i + 1;
+                for (std::size_t r = s.i + 2; r < s.j; ++r)
+                {
+                    if (robust_incircle<predicate_type, Statistics>(x_[p[s.i]], y_[p[s.i]], x_[p[s.j]], y_[p[s.j]], x_[p[c]], y_[p[c]], x_[p[r]], y_[p[r]]) > 0)
+                    {
+                        c = r;
+                    }
+                }
+
+                // The edge from p[c] to p[j] is opposite p[i], and that from p[i] to p[c] opposite p[j]
+                const index_type u = cavity[h++];
+                const std::size_t ends[2][2] = {{c, s.j}, {s.i, c}};
+                index_type adjacent[3] = {npos, npos, s.parent == npos ? npos : s.parent / 3};
+                bool constrained[2] = {false, false};
+                for (int m = 0; m < 2; ++m)
+                {
+                    if (ends[m][1] == ends[m][0] + 1)
+                    {
+                        cavity_edge& e = edges[ends[m][0]];
+                        constrained[m] = e.constrained;
+                        if (e.twin == npos)
+                        {
+                            adjacent[m] = e.outer;
+                            neighbors_[e.side] = u;
+                        }
+                        else
+                        {
+                            e.side = 3 * u + static_cast<index_type>(m);
+                        }
+                    }
+                    else
+                    {
+                        pending.push_back({ends[m][0], ends[m][1], 3 * u + static_cast<index_type>(m)});
+                    }
+                }
+                set_triangle(u, p[s.i], p[s.j], p[c], adjacent[0], adjacent[1], adjacent[2], constrained[0], constrained[1]);
+                if (s.parent != npos)
+                {
+                    neighbors_[s.parent] = u;
+                }
+            }
+            for (const cavity_edge& e : edges)
+            {
+                if (e.twin != npos)
+                {
+                    neighbors_[e.side] = edges[e.twin].side / 3;
+                }
+            }
+        }
+        neighbors_[3 * root[0] + 2] = root[1];
+        neighbors_[3 * root[1] + 2] = root[0];
+
+        set_constrained(a, b);
+    }
+
+    // Lawson's swapping from the given arcs, each swap adding the four outer arcs of its quadrilateral,
+    // until all are locally Delaunay; on_flip(t, u) is called with the two triangles of each swap
+    template <typename F>
+    void swap_illegal_arcs (std::vector<std::pair<index_type, index_type>>& arcs, F on_flip)
+    {
+        while (!arcs.empty())
+        {
+            const auto edge = arcs.back();
+            arcs.pop_back();
+
+            index_type t = 0;
+            int i = 0;
+            if (!find_edge(edge.first, edge.second, t, i) || !is_illegal(t, i))
+            {
+                continue;
+            }
+
+            // The four outer edges of the quadrilateral: those opposite p and q in both triangles
+            const index_type p = vertices_[3 * t + i];
+            const index_type u = flip(t, i);
+            const index_type q = vertices_[3 * t + (slot(t, p) + 2) % 3];
+            on_flip(t, u);
+            for (const index_type s : {t, u})
+            {
+                for (const index_type r : {p, q})
+                {
+                    const int k = slot(s, r);
+                    if (vertices_[3 * s + (k + 1) % 3] != npos && vertices_[3 * s + (k + 2) % 3] != npos)
+                    {
+                        arcs.emplace_back(vertices_[3 * s + (k + 1) % 3], vertices_[3 * s + (k + 2) % 3]);
+                    }
+                }
+            }
+        }
+    }
+
+    node_array<Real, Allocator> x_;
+    node_array<Real, Allocator> y_;
+
+    // Three entries per triangle
+    storage<index_type> vertices_;
+    storage<index_type> neighbors_;
+
+    // One bit per edge of each triangle, and 8 if the triangle lies in a hole
+    storage<unsigned char> constraints_;
+
+    // A triangle incident to each node
+    storage<index_type> incident_;
+
+    // Constraint curves, CSR-style
+    storage<index_type> constraint_nodes_;
+    storage<index_type> constraint_offsets_;
+    storage<predicate_type> constraint_areas_;
+    bool holes_ = false;
+
+    // The most recently written triangle, where the next walk starts
+    index_type last_ = 0;
+
+    // Scratch space for legalize
+    storage<index_type> stack_;
+
+    statistics_recorder<Statistics> stats_;
+};
+
+template <typename Real, typename Index, typename Allocator, typename Statistics>
+constexpr typename triangulation<Real, Index, Allocator, Statistics>::index_type triangulation<Real, Index, Allocator, Statistics>::npos;
+
+template <typename Real, typename Index, typename Allocator, typename Statistics>
+constexpr std::size_t triangulation<Real, Index, Allocator, Statistics>::stack_reserve;
+
+} // namespace detail
+
 }}} // Namespaces
 
 #endif // BOOST_MATH_INTERPOLATORS_DETAIL_TRIANGULATION_HPP
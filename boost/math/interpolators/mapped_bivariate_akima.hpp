@@ -0,0 +1,142 @@
+//  (C) Copyright Matt Borland 2022.
+//  Use, modification and distribution are subject to the
+//  Boost Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_MATH_INTERPOLATORS_MAPPED_BIVARIATE_AKIMA_HPP
+#define BOOST_MATH_INTERPOLATORS_MAPPED_BIVARIATE_AKIMA_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <boost/math/interpolators/detail/akima_image.hpp>
+
+namespace boost { namespace math { namespace interpolators {
+
+// A bivariate_akima or multichannel_bivariate_akima evaluated from the image that its save member wrote,
+// where the image lies: typically a read-only mapping of a file, whose pages the processes mapping it
+// share. Nothing is parsed or copied, so construction only checks the header, and the first queries
+// fault in the pages they touch. The memory must start at a multiple of 64 bytes, as mappings do, and
+// outlive the interpolator; Real and Index must be those of the interpolator that was saved.
+//
+// The values are those of the saved interpolator, bit for bit if it had a location index. Evaluation
+// is const and thread safe, as for bivariate_akima.
+template <class Real, class Index = std::uint32_t>
+class mapped_bivariate_akima
+{
+public:
+    using hint_type = typename detail::akima_image<Real, Index>::hint_type;
+
+    mapped_bivariate_akima (const void* data, std::size_t bytes)
+        : image_ {data, bytes}
+    {}
+
+    // The first channel
+    Real operator() (Real x, Real y) const
+    {
+        return (*this)(x, y, image_.thread_hint());
+    }
+
+    Real operator() (Real x, Real y, hint_type& hint) const
+    {
+        const auto t = image_.locate(x, y, hint);
+        if (image_.is_ghost(t))
+        {
+            return std::numeric_limits<Real>::quiet_NaN();
+        }
+
+        return image_.patch(t, 0)(x, y);
+    }
+
+    // out[c] is the value of channel c at (x, y)
+    template <class OutputContainer>
+    void operator() (Real x, Real y, OutputContainer& out) const
+    {
+        (*this)(x, y, out, image_.thread_hint());
+    }
+
+    template <class OutputContainer>
+    void operator() (Real x, Real y, OutputContainer& out, hint_type& hint) const
+    {
+        if (static_cast<std::size_t>(out.size()) != channels())
+        {
+            std::ostringstream oss;
+            oss << "There must be one output for each of the " << channels() << " channels, but there are " << out.size() << ".";
+            throw std::domain_error(oss.str());
+        }
+
+        const auto t = image_.locate(x, y, hint);
+        const bool ghost = image_.is_ghost(t);
+        auto result = std::begin(out);
+        for (std::size_t c = 0; c < channels(); ++c, ++result)
+        {
+            *result = ghost ? std::numeric_limits<Real>::quiet_NaN() : image_.patch(t, c)(x, y);
+        }
+    }
+
+    // As bivariate_akima::value_and_gradient and value_gradient_hessian, of the first channel
+    std::array<Real, 3> value_and_gradient (Real x, Real y) const
+    {
+        return value_and_gradient(x, y, image_.thread_hint());
+    }
+
+    std::array<Real, 3> value_and_gradient (Real x, Real y, hint_type& hint) const
+    {
+        std::array<Real, 3> result;
+        derivatives<1>(x, y, hint, result.data());
+        return result;
+    }
+
+    std::array<Real, 6> value_gradient_hessian (Real x, Real y) const
+    {
+        return value_gradient_hessian(x, y, image_.thread_hint());
+    }
+
+    std::array<Real, 6> value_gradient_hessian (Real x, Real y, hint_type& hint) const
+    {
+        std::array<Real, 6> result;
+        derivatives<2>(x, y, hint, result.data());
+        return result;
+    }
+
+    std::size_t channels () const
+    {
+        return image_.channels();
+    }
+
+    // Number of nodes
+    std::size_t size () const
+    {
+        return image_.size();
+    }
+
+    // As bivariate_akima::tables, pointing into the image
+    detail::akima_tables<Real, Index> tables () const
+    {
+        return image_.tables();
+    }
+
+private:
+    template <int Order>
+    void derivatives (Real x, Real y, hint_type& hint, Real* out) const
+    {
+        const auto t = image_.locate(x, y, hint);
+        if (image_.is_ghost(t))
+        {
+            std::fill(out, out + (Order == 1 ? 3 : 6), std::numeric_limits<Real>::quiet_NaN());
+            return;
+        }
+        image_.patch(t, 0).template derivatives<Order>(x, y, out);
+    }
+
+    detail::akima_image<Real, Index> image_;
+};
+
+}}} // Namespaces
+
+#endif // BOOST_MATH_INTERPOLATORS_MAPPED_BIVARIATE_AKIMA_HPP
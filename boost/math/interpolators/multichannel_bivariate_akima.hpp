@@ -0,0 +1,229 @@
+//  (C) Copyright Matt Borland 2022.
+//  Use, modification and distribution are subject to the
+//  Boost Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_MATH_INTERPOLATORS_MULTICHANNEL_BIVARIATE_AKIMA_HPP
+#define BOOST_MATH_INTERPOLATORS_MULTICHANNEL_BIVARIATE_AKIMA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+#include <boost/math/interpolators/detail/akima_image.hpp>
+#include <boost/math/interpolators/detail/akima_tables.hpp>
+#include <boost/math/interpolators/detail/bivariate_akima_detail.hpp>
+
+namespace boost { namespace math { namespace interpolators {
+
+// bivariate_akima of several fields on the same nodes at once. The triangulation, the nearest nodes of
+// each node and the least squares factorizations are shared by all channels, and the quintics of the
+// channels on a triangle are stored next to each other, so that one location serves them all.
+template <class RandomAccessContainer, class Index = std::uint32_t, class Statistics = no_statistics>
+class multichannel_bivariate_akima
+{
+public:
+    using Real = typename RandomAccessContainer::value_type;
+    using hint_type = typename detail::bivariate_akima_detail<RandomAccessContainer, Index, Statistics>::hint_type;
+
+    // z[channels * i + c] is the value of channel c at node (x[i], y[i])
+    multichannel_bivariate_akima (RandomAccessContainer&& x, RandomAccessContainer&& y, RandomAccessContainer&& z, std::size_t channels, std::size_t nearest = 12)
+        : impl_ {std::make_shared<detail::bivariate_akima_detail<RandomAccessContainer, Index, Statistics>>(std::move(x), std::move(y), std::move(z), channels, nearest)}
+    {}
+
+    template <class Executor>
+    multichannel_bivariate_akima (Executor&& executor, RandomAccessContainer&& x, RandomAccessContainer&& y, RandomAccessContainer&& z, std::size_t channels, std::size_t nearest = 12)
+        : impl_ {std::make_shared<detail::bivariate_akima_detail<RandomAccessContainer, Index, Statistics>>(std::forward<Executor>(executor), std::move(x), std::move(y), std::move(z), channels, nearest)}
+    {}
+
+    // As bivariate_akima with borrow_nodes, with the channels * n values laid out as above
+    multichannel_bivariate_akima (borrow_nodes_t, const Real* x, const Real* y, const Real* z, std::size_t n, std::size_t channels, std::size_t nearest = 12)
+        : impl_ {std::make_shared<detail::bivariate_akima_detail<RandomAccessContainer, Index, Statistics>>(borrow_nodes, x, y, z, n, channels, nearest)}
+    {}
+
+    template <class Executor>
+    multichannel_bivariate_akima (Executor&& executor, borrow_nodes_t, const Real* x, const Real* y, const Real* z, std::size_t n, std::size_t channels, std::size_t nearest = 12)
+        : impl_ {std::make_shared<detail::bivariate_akima_detail<RandomAccessContainer, Index, Statistics>>(std::forward<Executor>(executor), borrow_nodes, x, y, z, n, channels, nearest)}
+    {}
+
+    // out[c] is the value of channel c at (x, y)
+    template <class OutputContainer>
+    void operator() (Real x, Real y, OutputContainer& out) const
+    {
+        (*this)(x, y, out, impl_->thread_hint());
+    }
+
+    template <class OutputContainer>
+    void operator() (Real x, Real y, OutputContainer& out, hint_type& hint) const
+    {
+        if (static_cast<std::size_t>(out.size()) != channels())
+        {
+            std::ostringstream oss;
+            oss << "There must be one output for each of the " << channels() << " channels, but there are " << out.size() << ".";
+            throw std::domain_error(oss.str());
+        }
+        impl_->channel_values(x, y, hint, std::begin(out));
+    }
+
+    // out[3 * c], out[3 * c + 1], out[3 * c + 2] are z, z_x and z_y of channel c at (x, y), as
+    // bivariate_akima::value_and_gradient
+    template <class OutputContainer>
+    void value_and_gradient (Real x, Real y, OutputContainer& out) const
+    {
+        value_and_gradient(x, y, out, impl_->thread_hint());
+    }
+
+    template <class OutputContainer>
+    void value_and_gradient (Real x, Real y, OutputContainer& out, hint_type& hint) const
+    {
+        check_outputs(out, 3);
+        impl_->template channel_derivatives<1>(x, y, hint, std::begin(out));
+    }
+
+    // out[6 * c], ..., out[6 * c + 5] are z, z_x, z_y, z_xx, z_xy and z_yy of channel c at (x, y)
+    template <class OutputContainer>
+    void value_gradient_hessian (Real x, Real y, OutputContainer& out) const
+    {
+        value_gradient_hessian(x, y, out, impl_->thread_hint());
+    }
+
+    template <class OutputContainer>
+    void value_gradient_hessian (Real x, Real y, OutputContainer& out, hint_type& hint) const
+    {
+        check_outputs(out, 6);
+        impl_->template channel_derivatives<2>(x, y, hint, std::begin(out));
+    }
+
+    // out[c] is bivariate_akima::linear of channel c at (x, y)
+    template <class OutputContainer>
+    void linear (Real x, Real y, OutputContainer& out) const
+    {
+        linear(x, y, out, impl_->thread_hint());
+    }
+
+    template <class OutputContainer>
+    void linear (Real x, Real y, OutputContainer& out, hint_type& hint) const
+    {
+        check_outputs(out, 1);
+        impl_->linear_values(x, y, hint, std::begin(out));
+    }
+
+    // out[c] is bivariate_akima::natural_neighbor of channel c at (x, y), with the weights of the nodes
+    // computed once for all channels
+    template <class OutputContainer>
+    void natural_neighbor (Real x, Real y, OutputContainer& out) const
+    {
+        natural_neighbor(x, y, out, impl_->thread_hint());
+    }
+
+    template <class OutputContainer>
+    void natural_neighbor (Real x, Real y, OutputContainer& out, hint_type& hint) const
+    {
+        check_outputs(out, 1);
+        impl_->natural_neighbor_values(x, y, hint, std::begin(out));
+    }
+
+    std::size_t channels () const
+    {
+        return impl_->channels();
+    }
+
+    // As bivariate_akima::refit, with z laid out as in the constructor
+    void refit (RandomAccessContainer&& z)
+    {
+        detail::sequential_executor executor;
+        impl_->refit(std::move(z), executor);
+    }
+
+    template <class Executor>
+    void refit (Executor&& executor, RandomAccessContainer&& z)
+    {
+        impl_->refit(std::move(z), executor);
+    }
+
+    // As bivariate_akima::insert, with z[c] the value of channel c at (x, y)
+    template <class InputContainer>
+    std::size_t insert (Real x, Real y, const InputContainer& z)
+    {
+        if (static_cast<std::size_t>(z.size()) != channels())
+        {
+            std::ostringstream oss;
+            oss << "There must be one value for each of the " << channels() << " channels, but there are " << z.size() << ".";
+            throw std::domain_error(oss.str());
+        }
+        return impl_->insert(x, y, std::cbegin(z));
+    }
+
+    void erase (std::size_t node)
+    {
+        impl_->erase(node);
+    }
+
+    void index_locations (double cells_per_node = 1)
+    {
+        impl_->index_locations(cells_per_node);
+    }
+
+    // As bivariate_akima::rasterize, of channel c
+    void rasterize (const grid_spec<Real>& grid, std::size_t c, Real* out) const
+    {
+        detail::sequential_executor executor;
+        impl_->rasterize(grid, c, out, executor);
+    }
+
+    template <class Executor>
+    void rasterize (Executor&& executor, const grid_spec<Real>& grid, std::size_t c, Real* out) const
+    {
+        impl_->rasterize(grid, c, out, executor);
+    }
+
+    // The memory held by the interpolator, including the nodes and values unless they are borrowed
+    std::size_t bytes () const
+    {
+        return impl_->bytes();
+    }
+
+    bivariate_akima_statistics statistics () const
+    {
+        return impl_->statistics();
+    }
+
+    void reset_statistics ()
+    {
+        impl_->reset_statistics();
+    }
+
+    // As bivariate_akima::save, with the quintics of all channels
+    void save (std::ostream& os) const
+    {
+        detail::write_akima_image(os, *impl_);
+    }
+
+    // As bivariate_akima::tables, with the quintics of all channels
+    detail::akima_tables<Real, Index> tables () const
+    {
+        return detail::make_akima_tables(*impl_);
+    }
+
+private:
+    template <class OutputContainer>
+    void check_outputs (const OutputContainer& out, std::size_t per_channel) const
+    {
+        if (static_cast<std::size_t>(out.size()) != per_channel * channels())
+        {
+            std::ostringstream oss;
+            oss << "There must be " << per_channel << " outputs for each of the " << channels() << " channels, but there are " << out.size() << ".";
+            throw std::domain_error(oss.str());
+        }
+    }
+
+    std::shared_ptr<detail::bivariate_akima_detail<RandomAccessContainer, Index, Statistics>> impl_;
+};
+
+}}} // Namespaces
+
+#endif // BOOST_MATH_INTERPOLATORS_MULTICHANNEL_BIVARIATE_AKIMA_HPP
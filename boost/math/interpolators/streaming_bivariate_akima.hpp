@@ -0,0 +1,311 @@
+//  (C) Copyright Matt Borland 2022.
+//  Use, modification and distribution are subject to the
+//  Boost Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_MATH_INTERPOLATORS_STREAMING_BIVARIATE_AKIMA_HPP
+#define BOOST_MATH_INTERPOLATORS_STREAMING_BIVARIATE_AKIMA_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include <boost/align/aligned_allocator.hpp>
+#include <boost/math/tools/promotion.hpp>
+#include <boost/math/interpolators/detail/bivariate_akima_detail.hpp>
+#include <boost/math/interpolators/detail/streaming_triangulation.hpp>
+
+namespace boost { namespace math { namespace interpolators {
+
+// bivariate_akima of a point cloud too large to hold, fitted as it streams past: the points arrive in
+// chunks sorted by abscissa, as in detail/streaming_triangulation.hpp, and each triangle is written to a
+// sink with its quintics once it is final and the derivatives at its vertices are known. The nodes held
+// are those of a strip along the front, so that the memory depends on the width of the strip rather
+// than on the number of points; the triangles and coefficients are for the caller to store, on disk or
+// elsewhere.
+//
+// The derivatives at a node are estimated once no later point can be nearer to it than its nearest
+// nodes. A node is kept while it is among the nearest nodes of a node still waiting, and while it is
+// within reach of the front, so reach must bound the distance from any point to the farthest of its
+// nearest nodes: then the derivatives are bitwise those of bivariate_akima on all of the points, and
+// the quintics equal its quintics up to rounding, as the triangles may list their vertices in another
+// order. Where reach is too short, the estimates near the front use the nearest nodes held. Constraint
+// curves are not supported, as bivariate_akima takes none; those of a triangulation alone are streamed
+// by detail::streaming_triangulation.
+template <class Real, class Index = std::uint32_t>
+class streaming_bivariate_akima
+{
+public:
+    using index_type = Index;
+
+    // The box must hold all of the points
+    streaming_bivariate_akima (Real x_min, Real x_max, Real y_min, Real y_max, Real reach, std::size_t channels = 1, std::size_t nearest = 12)
+        : stream_ {x_min, x_max, y_min, y_max}, reach_ {reach}, channels_ {channels}, nearest_ {nearest}
+    {
+        if (channels == 0)
+        {
+            throw std::domain_error("There must be at least one channel.");
+        }
+        if (nearest < 2)
+        {
+            std::ostringstream oss;
+            oss << "At least 2 nearest nodes are required to estimate the derivatives, but " << nearest << " were requested.";
+            throw std::domain_error(oss.str());
+        }
+        if (!(reach >= 0))
+        {
+            std::ostringstream oss;
+            oss << "The reach of the nearest nodes must not be negative, but is " << reach << ".";
+            throw std::domain_error(oss.str());
+        }
+        patch_.resize(channels);
+    }
+
+    // Adds the chunk of nodes (x[i], y[i]), with z[channels * i + c] the value of channel c at node i,
+    // whose abscissas are at least the front of the previous chunk, and declares that the abscissas of
+    // the later chunks are at least front. For each triangle completed, calls sink(a, b, c, patches)
+    // with the numbers of its counterclockwise vertices in the stream, counted from 0, and the quintics
+    // of the channels on it, patches[0], ..., patches[channels - 1].
+    template <class InputContainer, class Sink>
+    void push (const InputContainer& x, const InputContainer& y, const InputContainer& z, Real front, Sink&& sink)
+    {
+        if (static_cast<std::size_t>(x.size()) * channels_ != static_cast<std::size_t>(z.size()))
+        {
+            std::ostringstream oss;
+            oss << "There must be " << channels_ << " values at each of the " << x.size() << " nodes, but there are " << z.size() << " values.";
+            throw std::domain_error(oss.str());
+        }
+
+        auto values = std::cbegin(z);
+        stream_.insert(std::cbegin(x), std::cend(x), std::cbegin(y), std::cend(y), [&](std::size_t k)
+        {
+            const auto first = values + static_cast<std::ptrdiff_t>(channels_ * k);
+            z_.insert(z_.end(), first, first + static_cast<std::ptrdiff_t>(channels_));
+            derivatives_.resize(derivatives_.size() + 5 * channels_);
+            done_.push_back(0);
+            pinned_.push_back(0);
+        });
+        stream_.advance(front);
+        step(sink);
+    }
+
+    // Ends the stream and writes the remaining triangles
+    template <class Sink>
+    void finish (Sink&& sink)
+    {
+        stream_.close();
+
+        // With no more nodes than requested, each node uses all of the others, as in bivariate_akima
+        nearest_ = (std::min)(nearest_, static_cast<std::size_t>(stream_.size() - 1));
+        step(sink);
+    }
+
+    std::size_t channels () const
+    {
+        return channels_;
+    }
+
+    // The nodes received
+    std::uint64_t size () const
+    {
+        return stream_.size();
+    }
+
+    // The nodes held
+    std::size_t active () const
+    {
+        return stream_.active();
+    }
+
+    std::size_t bytes () const
+    {
+        return stream_.bytes() + z_.capacity() * sizeof(Real) + derivatives_.capacity() * sizeof(fit_type) + done_.capacity() + pinned_.capacity() +
+               patch_.capacity() * sizeof(detail::akima_patch<Real>) +
+               heap_.capacity() * sizeof(candidate) + (scratch_.nodes.capacity() + scratch_.ring.capacity() + scratch_.seen.capacity()) * sizeof(index_type) +
+               (scratch_.matrix.capacity() + scratch_.rhs.capacity() + scratch_.solution.capacity()) * sizeof(fit_type) + sizeof(*this);
+    }
+
+private:
+    using stream_type = detail::streaming_triangulation<Real, Index>;
+
+    // As in bivariate_akima, the derivatives and the quintics are computed in the promoted type
+    using fit_type = typename boost::math::tools::promote_args<Real, double>::type;
+
+    // The squared distance, the number in the stream and the index of a node, so that equidistant nodes
+    // are taken in the order that bivariate_akima takes them
+    using candidate = std::pair<fit_type, std::pair<std::uint64_t, index_type>>;
+
+    template <class Sink>
+    void step (Sink& sink)
+    {
+        if (stream_.empty())
+        {
+            return;
+        }
+
+        estimate();
+        stream_.emit([this](index_type t)
+        {
+            const auto& tri = stream_.get_triangulation();
+            return done_[tri.vertex(t, 0)] && done_[tri.vertex(t, 1)] && done_[tri.vertex(t, 2)];
+        },
+        [this, &sink](index_type t)
+        {
+            fit_patches(t);
+            const auto& tri = stream_.get_triangulation();
+            sink(stream_.node_id(tri.vertex(t, 0)), stream_.node_id(tri.vertex(t, 1)), stream_.node_id(tri.vertex(t, 2)),
+                 static_cast<const detail::akima_patch<Real>*>(patch_.data()));
+        });
+        stream_.retire([this](index_type v)
+        {
+            return !done_[v] || pinned_[v] || !(stream_.get_triangulation().x(v) + reach_ < stream_.front());
+        },
+        [this](index_type v, index_type last)
+        {
+            if (v != last)
+            {
+                std::copy(z_.begin() + static_cast<std::ptrdiff_t>(channels_ * last), z_.begin() + static_cast<std::ptrdiff_t>(channels_ * (last + 1)),
+                          z_.begin() + static_cast<std::ptrdiff_t>(channels_ * v));
+                std::copy(derivatives_.begin() + static_cast<std::ptrdiff_t>(5 * channels_ * last),
+                          derivatives_.begin() + static_cast<std::ptrdiff_t>(5 * channels_ * (last + 1)),
+                          derivatives_.begin() + static_cast<std::ptrdiff_t>(5 * channels_ * v));
+                done_[v] = done_[last];
+                pinned_[v] = pinned_[last];
+            }
+            z_.resize(channels_ * last);
+            derivatives_.resize(5 * channels_ * last);
+            done_.pop_back();
+            pinned_.pop_back();
+        });
+    }
+
+    // Estimates the derivatives at the nodes whose nearest nodes are settled, and pins the nearest nodes
+    // found so far of the others
+    void estimate ()
+    {
+        const auto& tri = stream_.get_triangulation();
+        const Real front = stream_.front();
+        std::fill(pinned_.begin(), pinned_.end(), char(0));
+        for (index_type v = 0; v < tri.size(); ++v)
+        {
+            if (done_[v])
+            {
+                continue;
+            }
+
+            nearest_nodes(v);
+            const fit_type dx = static_cast<fit_type>(tri.x(scratch_.nodes.back())) - tri.x(v);
+            const fit_type dy = static_cast<fit_type>(tri.y(scratch_.nodes.back())) - tri.y(v);
+            const fit_type radius2 = dx * dx + dy * dy;
+
+            // A later node (x, y) has x - x(v) >= front - x(v) in floating point too, so it is no nearer
+            const fit_type gap = static_cast<fit_type>(front) - tri.x(v);
+            if (scratch_.nodes.size() == nearest_ && gap > 0 && gap * gap >= radius2)
+            {
+                detail::estimate_akima_derivatives(v, scratch_.nodes.data(), static_cast<index_type>(nearest_), radius2, channels_,
+                                                   [&tri](index_type u) { return static_cast<fit_type>(tri.x(u)); },
+                                                   [&tri](index_type u) { return static_cast<fit_type>(tri.y(u)); },
+                                                   [this](index_type u, std::size_t c) { return static_cast<fit_type>(z_[channels_ * u + c]); },
+                                                   scratch_, &derivatives_[5 * channels_ * v]);
+                done_[v] = 1;
+            }
+            else
+            {
+                for (const index_type u : scratch_.nodes)
+                {
+                    pinned_[u] = 1;
+                }
+            }
+        }
+    }
+
+    // The nearest_ nodes held closest to v, nearest first, by the best-first search of bivariate_akima;
+    // the nodes held are triangulated by Delaunay, so the search finds all of them
+    void nearest_nodes (index_type v)
+    {
+        const auto& tri = stream_.get_triangulation();
+        const fit_type px = tri.x(v);
+        const fit_type py = tri.y(v);
+        auto expand = [&](index_type u)
+        {
+            scratch_.ring.clear();
+            tri.neighbors(u, std::back_inserter(scratch_.ring));
+            for (const index_type w : scratch_.ring)
+            {
+                if (scratch_.see(w))
+                {
+                    const fit_type dx = tri.x(w) - px;
+                    const fit_type dy = tri.y(w) - py;
+                    heap_.emplace_back(dx * dx + dy * dy, std::make_pair(stream_.node_id(w), w));
+                    std::push_heap(heap_.begin(), heap_.end(), std::greater<candidate>());
+                }
+            }
+        };
+
+        scratch_.clear_seen(8 * (nearest_ + 1));
+        heap_.clear();
+        scratch_.nodes.clear();
+        scratch_.see(v);
+        expand(v);
+        while (scratch_.nodes.size() < nearest_ && !heap_.empty())
+        {
+            std::pop_heap(heap_.begin(), heap_.end(), std::greater<candidate>());
+            const index_type u = heap_.back().second.second;
+            heap_.pop_back();
+            scratch_.nodes.push_back(u);
+            expand(u);
+        }
+    }
+
+    void fit_patches (index_type t)
+    {
+        const auto& tri = stream_.get_triangulation();
+        fit_type x[3];
+        fit_type y[3];
+        index_type v[3];
+        for (int i = 0; i < 3; ++i)
+        {
+            v[i] = tri.vertex(t, i);
+            x[i] = tri.x(v[i]);
+            y[i] = tri.y(v[i]);
+        }
+        for (std::size_t c = 0; c < channels_; ++c)
+        {
+            fit_type z[3];
+            const fit_type* d[3];
+            for (int i = 0; i < 3; ++i)
+            {
+                z[i] = z_[channels_ * v[i] + c];
+                d[i] = &derivatives_[5 * (channels_ * v[i] + c)];
+            }
+            detail::fit_akima_patch(patch_[c], x, y, z, d);
+        }
+    }
+
+    stream_type stream_;
+    Real reach_;
+    std::size_t channels_;
+    std::size_t nearest_;
+
+    // By node held: the values of the channels, their derivatives z_x, z_y, z_xx, z_xy, z_yy, whether
+    // those are estimated, and whether the node is among the nearest nodes of a node still waiting
+    std::vector<Real> z_;
+    std::vector<fit_type> derivatives_;
+    std::vector<char> done_;
+    std::vector<char> pinned_;
+
+    std::vector<detail::akima_patch<Real>, boost::alignment::aligned_allocator<detail::akima_patch<Real>, 64>> patch_;
+    detail::akima_scratch<fit_type, index_type> scratch_;
+    std::vector<candidate> heap_;
+};
+
+}}} // Namespaces
+
+#endif // BOOST_MATH_INTERPOLATORS_STREAMING_BIVARIATE_AKIMA_HPP
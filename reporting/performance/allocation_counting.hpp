@@ -0,0 +1,169 @@
+//  (C) Copyright Matt Borland 2022.
+//  Use, modification and distribution are subject to the
+//  Boost Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_MATH_INTERPOLATORS_REPORTING_ALLOCATION_COUNTING_HPP
+#define BOOST_MATH_INTERPOLATORS_REPORTING_ALLOCATION_COUNTING_HPP
+
+// Replaces the global allocation functions, so it is included by exactly one translation unit of a
+// benchmark executable
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <boost/config.hpp>
+
+// Every allocation made by the process is counted so that the benchmarks can report allocations per call
+static std::atomic<std::size_t> allocations {0};
+
+// All forms of operator new and operator delete go through this pair, over std::malloc and std::free.
+// It is kept out of line so that the compiler, inlining a delete expression, does not see std::free
+// applied to the result of operator new.
+BOOST_NOINLINE static void* counted_allocate (std::size_t count) noexcept
+{
+    ++allocations;
+    return std::malloc(count == 0 ? 1 : count);
+}
+
+BOOST_NOINLINE static void counted_deallocate (void* p) noexcept
+{
+    std::free(p);
+}
+
+void* operator new (std::size_t count)
+{
+    if (void* p = counted_allocate(count))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[] (std::size_t count)
+{
+    return operator new(count);
+}
+
+void* operator new (std::size_t count, const std::nothrow_t&) noexcept
+{
+    return counted_allocate(count);
+}
+
+void* operator new[] (std::size_t count, const std::nothrow_t&) noexcept
+{
+    return counted_allocate(count);
+}
+
+void operator delete (void* p) noexcept
+{
+    counted_deallocate(p);
+}
+
+void operator delete[] (void* p) noexcept
+{
+    counted_deallocate(p);
+}
+
+void operator delete (void* p, std::size_t) noexcept
+{
+    counted_deallocate(p);
+}
+
+void operator delete[] (void* p, std::size_t) noexcept
+{
+    counted_deallocate(p);
+}
+
+void operator delete (void* p, const std::nothrow_t&) noexcept
+{
+    counted_deallocate(p);
+}
+
+void operator delete[] (void* p, const std::nothrow_t&) noexcept
+{
+    counted_deallocate(p);
+}
+
+#ifdef __cpp_aligned_new
+// Over-aligned allocations keep the pointer that std::malloc returned just below the aligned block
+BOOST_NOINLINE static void* counted_allocate (std::size_t count, std::align_val_t alignment) noexcept
+{
+    const auto align = (std::max)(static_cast<std::size_t>(alignment), sizeof(void*));
+    void* raw = counted_allocate(count + align);
+    if (raw == nullptr)
+    {
+        return nullptr;
+    }
+    const auto address = (reinterpret_cast<std::uintptr_t>(raw) + align) & ~static_cast<std::uintptr_t>(align - 1);
+    reinterpret_cast<void**>(address)[-1] = raw;
+    return reinterpret_cast<void*>(address);
+}
+
+BOOST_NOINLINE static void counted_deallocate (void* p, std::align_val_t) noexcept
+{
+    if (p != nullptr)
+    {
+        counted_deallocate(static_cast<void**>(p)[-1]);
+    }
+}
+
+void* operator new (std::size_t count, std::align_val_t alignment)
+{
+    if (void* p = counted_allocate(count, alignment))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[] (std::size_t count, std::align_val_t alignment)
+{
+    return operator new(count, alignment);
+}
+
+void* operator new (std::size_t count, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return counted_allocate(count, alignment);
+}
+
+void* operator new[] (std::size_t count, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return counted_allocate(count, alignment);
+}
+
+void operator delete (void* p, std::align_val_t alignment) noexcept
+{
+    counted_deallocate(p, alignment);
+}
+
+void operator delete[] (void* p, std::align_val_t alignment) noexcept
+{
+    counted_deallocate(p, alignment);
+}
+
+void operator delete (void* p, std::size_t, std::align_val_t alignment) noexcept
+{
+    counted_deallocate(p, alignment);
+}
+
+void operator delete[] (void* p, std::size_t, std::align_val_t alignment) noexcept
+{
+    counted_deallocate(p, alignment);
+}
+
+void operator delete (void* p, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    counted_deallocate(p, alignment);
+}
+
+void operator delete[] (void* p, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    counted_deallocate(p, alignment);
+}
+#endif
+
+#endif // BOOST_MATH_INTERPOLATORS_REPORTING_ALLOCATION_COUNTING_HPP
@@ -0,0 +1,409 @@
+//  (C) Copyright Matt Borland 2022.
+//  Use, modification and distribution are subject to the
+//  Boost Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <boost/math/interpolators/bivariate_akima.hpp>
+#include <boost/math/interpolators/detail/thread_executor.hpp>
+#include <boost/math/interpolators/detail/triangulation.hpp>
+#include "allocation_counting.hpp"
+
+// The largest point set; 10^7 and 10^8 take minutes and gigabytes, so they are opt-in through CMake
+#ifndef BIVARIATE_BENCHMARK_MAX_POINTS
+#define BIVARIATE_BENCHMARK_MAX_POINTS 1000000
+#endif
+
+using boost::math::interpolators::bivariate_akima;
+using boost::math::interpolators::detail::thread_executor;
+using boost::math::interpolators::detail::triangulation;
+
+// Reproducible point sets in the unit square, each from its own fixed seed
+
+// Independent uniform points
+struct uniform
+{
+    static void generate(std::size_t n, std::vector<double>& x, std::vector<double>& y)
+    {
+        std::mt19937_64 gen(1);
+        std::uniform_real_distribution<double> dis(0, 1);
+        x.resize(n);
+        y.resize(n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            x[i] = dis(gen);
+            y[i] = dis(gen);
+        }
+    }
+};
+
+// Gaussian clusters of very different densities, where walks without an index are long
+struct clustered
+{
+    static void generate(std::size_t n, std::vector<double>& x, std::vector<double>& y)
+    {
+        std::mt19937_64 gen(2);
+        std::uniform_real_distribution<double> center(0.1, 0.9);
+        std::uniform_int_distribution<int> scale(2, 5);
+        constexpr int clusters = 64;
+        double cx[clusters];
+        double cy[clusters];
+        double sigma[clusters];
+        for (int k = 0; k < clusters; ++k)
+        {
+            cx[k] = center(gen);
+            cy[k] = center(gen);
+            sigma[k] = std::pow(10.0, -scale(gen));
+        }
+
+        std::uniform_int_distribution<int> pick(0, clusters - 1);
+        std::normal_distribution<double> normal(0, 1);
+        x.resize(n);
+        y.resize(n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const int k = pick(gen);
+            x[i] = cx[k] + sigma[k] * normal(gen);
+            y[i] = cy[k] + sigma[k] * normal(gen);
+        }
+    }
+};
+
+// A square grid in scan order, whose cells are all cocircular
+struct gridded
+{
+    static void generate(std::size_t n, std::vector<double>& x, std::vector<double>& y)
+    {
+        const auto side = static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(n))));
+        x.resize(n);
+        y.resize(n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            x[i] = static_cast<double>(i % side) / static_cast<double>(side);
+            y[i] = static_cast<double>(i / side) / static_cast<double>(side);
+        }
+    }
+};
+
+// Survey lines: a slightly rotated grid whose nodes are moved by a few ulps, so that nearly every
+// orientation and incircle test is within rounding of zero
+struct near_degenerate
+{
+    static void generate(std::size_t n, std::vector<double>& x, std::vector<double>& y)
+    {
+        std::mt19937_64 gen(4);
+        std::uniform_int_distribution<int> ulps(-4, 4);
+        const auto side = static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(n))));
+        const double c = std::cos(1e-3);
+        const double s = std::sin(1e-3);
+        x.resize(n);
+        y.resize(n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const double u = static_cast<double>(i % side) / static_cast<double>(side);
+            const double v = static_cast<double>(i / side) / static_cast<double>(side);
+            x[i] = 0.5 + c * u - s * v + ulps(gen) * std::numeric_limits<double>::epsilon();
+            y[i] = 0.5 + s * u + c * v + ulps(gen) * std::numeric_limits<double>::epsilon();
+        }
+    }
+};
+
+// Franke's function
+double franke(double x, double y)
+{
+    return 0.75 * std::exp(-((9 * x - 2) * (9 * x - 2) + (9 * y - 2) * (9 * y - 2)) / 4) +
+           0.75 * std::exp(-(9 * x + 1) * (9 * x + 1) / 49 - (9 * y + 1) / 10) +
+           0.5 * std::exp(-((9 * x - 7) * (9 * x - 7) + (9 * y - 3) * (9 * y - 3)) / 4) -
+           0.2 * std::exp(-(9 * x - 4) * (9 * x - 4) - (9 * y - 7) * (9 * y - 7));
+}
+
+template <typename PointSet, typename Real = double>
+bivariate_akima<std::vector<Real>> make_interpolator(std::size_t n)
+{
+    std::vector<double> x, y;
+    PointSet::generate(n, x, y);
+    std::vector<Real> z(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        z[i] = static_cast<Real>(franke(x[i], y[i]));
+    }
+    bivariate_akima<std::vector<Real>> akima(thread_executor(), std::vector<Real>(x.begin(), x.end()), std::vector<Real>(y.begin(), y.end()), std::move(z));
+    akima.index_locations();
+    return akima;
+}
+
+// Queries in random order inside of the unit square
+void make_queries(std::size_t n, std::vector<double>& x, std::vector<double>& y)
+{
+    std::mt19937_64 gen(5);
+    std::uniform_real_distribution<double> dis(0, 1);
+    x.resize(n);
+    y.resize(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        x[i] = dis(gen);
+        y[i] = dis(gen);
+    }
+}
+
+void set_point_counters(benchmark::State& state, std::size_t points, std::size_t bytes)
+{
+    state.counters["points/s"] = benchmark::Counter(static_cast<double>(points), benchmark::Counter::kIsIterationInvariantRate);
+    state.counters["bytes/point"] = static_cast<double>(bytes) / static_cast<double>(points);
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(points));
+    state.SetComplexityN(static_cast<std::int64_t>(points));
+}
+
+template <typename PointSet>
+void TriangulationBuild(benchmark::State& state)
+{
+    std::vector<double> x, y;
+    const auto n = static_cast<std::size_t>(state.range(0));
+    PointSet::generate(n, x, y);
+
+    std::size_t bytes = 0;
+    for (auto _ : state)
+    {
+        const triangulation<double> tri(x, y);
+        bytes = tri.bytes();
+        benchmark::DoNotOptimize(bytes);
+    }
+    set_point_counters(state, n, bytes);
+}
+
+template <typename PointSet>
+void TriangulationBuildPartitioned(benchmark::State& state)
+{
+    std::vector<double> x, y;
+    const auto n = static_cast<std::size_t>(state.range(0));
+    PointSet::generate(n, x, y);
+
+    std::size_t bytes = 0;
+    for (auto _ : state)
+    {
+        const triangulation<double> tri(x, y, thread_executor());
+        bytes = tri.bytes();
+        benchmark::DoNotOptimize(bytes);
+    }
+    set_point_counters(state, n, bytes);
+}
+
+// Triangulation, derivatives and quintics
+template <typename PointSet>
+void AkimaFit(benchmark::State& state)
+{
+    std::vector<double> x, y;
+    const auto n = static_cast<std::size_t>(state.range(0));
+    PointSet::generate(n, x, y);
+    std::vector<double> z(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        z[i] = franke(x[i], y[i]);
+    }
+
+    std::size_t bytes = 0;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        std::vector<double> xc = x, yc = y, zc = z;
+        state.ResumeTiming();
+        const bivariate_akima<std::vector<double>> akima(std::move(xc), std::move(yc), std::move(zc));
+        bytes = akima.bytes();
+        benchmark::DoNotOptimize(bytes);
+    }
+    set_point_counters(state, n, bytes);
+}
+
+// The derivatives and quintics alone, on the neighborhoods kept from the construction
+template <typename PointSet>
+void AkimaRefit(benchmark::State& state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    auto akima = make_interpolator<PointSet>(n);
+    std::vector<double> z(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        z[i] = static_cast<double>(i % 7);
+    }
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        std::vector<double> zc = z;
+        state.ResumeTiming();
+        akima.refit(std::move(zc));
+    }
+    set_point_counters(state, n, akima.bytes());
+}
+
+template <typename PointSet>
+void AkimaScalarEvaluation(benchmark::State& state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto akima = make_interpolator<PointSet>(n);
+    std::vector<double> qx, qy;
+    make_queries(1 << 16, qx, qy);
+
+    const std::size_t start = allocations;
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < qx.size(); ++i)
+        {
+            benchmark::DoNotOptimize(akima(qx[i], qy[i]));
+        }
+    }
+    state.counters["allocations/call"] = benchmark::Counter(static_cast<double>(allocations - start),
+                                                            benchmark::Counter::kAvgIterations);
+    state.counters["queries/s"] = benchmark::Counter(static_cast<double>(qx.size()), benchmark::Counter::kIsIterationInvariantRate);
+    state.counters["bytes/point"] = static_cast<double>(akima.bytes()) / static_cast<double>(n);
+    state.SetComplexityN(static_cast<std::int64_t>(n));
+}
+
+template <typename PointSet>
+void LinearScalarEvaluation(benchmark::State& state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto akima = make_interpolator<PointSet>(n);
+    std::vector<double> qx, qy;
+    make_queries(1 << 16, qx, qy);
+
+    const std::size_t start = allocations;
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < qx.size(); ++i)
+        {
+            benchmark::DoNotOptimize(akima.linear(qx[i], qy[i]));
+        }
+    }
+    state.counters["allocations/call"] = benchmark::Counter(static_cast<double>(allocations - start),
+                                                            benchmark::Counter::kAvgIterations);
+    state.counters["queries/s"] = benchmark::Counter(static_cast<double>(qx.size()), benchmark::Counter::kIsIterationInvariantRate);
+    state.SetComplexityN(static_cast<std::int64_t>(n));
+}
+
+template <typename PointSet>
+void NaturalNeighborScalarEvaluation(benchmark::State& state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto akima = make_interpolator<PointSet>(n);
+    std::vector<double> qx, qy;
+    make_queries(1 << 16, qx, qy);
+
+    const std::size_t start = allocations;
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < qx.size(); ++i)
+        {
+            benchmark::DoNotOptimize(akima.natural_neighbor(qx[i], qy[i]));
+        }
+    }
+    state.counters["allocations/call"] = benchmark::Counter(static_cast<double>(allocations - start),
+                                                            benchmark::Counter::kAvgIterations);
+    state.counters["queries/s"] = benchmark::Counter(static_cast<double>(qx.size()), benchmark::Counter::kIsIterationInvariantRate);
+    state.SetComplexityN(static_cast<std::int64_t>(n));
+}
+
+template <typename PointSet>
+void AkimaBatchedEvaluation(benchmark::State& state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto akima = make_interpolator<PointSet>(n);
+    std::vector<double> qx, qy;
+    make_queries(1 << 16, qx, qy);
+    std::vector<double> out(qx.size());
+
+    for (auto _ : state)
+    {
+        akima.evaluate(qx, qy, out);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.counters["queries/s"] = benchmark::Counter(static_cast<double>(qx.size()), benchmark::Counter::kIsIterationInvariantRate);
+    state.counters["bytes/point"] = static_cast<double>(akima.bytes()) / static_cast<double>(n);
+    state.SetComplexityN(static_cast<std::int64_t>(n));
+}
+
+// Float nodes, values and quintics, located and fitted in double, evaluated in float lanes
+template <typename PointSet>
+void AkimaBatchedFloatEvaluation(benchmark::State& state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto akima = make_interpolator<PointSet, float>(n);
+    std::vector<double> qx, qy;
+    make_queries(1 << 16, qx, qy);
+    const std::vector<float> fx(qx.begin(), qx.end()), fy(qy.begin(), qy.end());
+    std::vector<float> out(qx.size());
+
+    for (auto _ : state)
+    {
+        akima.evaluate(fx, fy, out);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.counters["queries/s"] = benchmark::Counter(static_cast<double>(qx.size()), benchmark::Counter::kIsIterationInvariantRate);
+    state.counters["bytes/point"] = static_cast<double>(akima.bytes()) / static_cast<double>(n);
+    state.SetComplexityN(static_cast<std::int64_t>(n));
+}
+
+template <typename PointSet>
+void AkimaBatchedHessianEvaluation(benchmark::State& state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto akima = make_interpolator<PointSet>(n);
+    std::vector<double> qx, qy;
+    make_queries(1 << 16, qx, qy);
+    std::vector<double> out(6 * qx.size());
+
+    for (auto _ : state)
+    {
+        akima.evaluate_value_gradient_hessian(qx, qy, out);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.counters["queries/s"] = benchmark::Counter(static_cast<double>(qx.size()), benchmark::Counter::kIsIterationInvariantRate);
+    state.counters["bytes/point"] = static_cast<double>(akima.bytes()) / static_cast<double>(n);
+    state.SetComplexityN(static_cast<std::int64_t>(n));
+}
+
+// A 256 by 256 grid over the unit square, as many points as the query sets above
+template <typename PointSet>
+void AkimaRasterize(benchmark::State& state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto akima = make_interpolator<PointSet>(n);
+    const boost::math::interpolators::grid_spec<double> grid {0, 0, 1.0 / 255, 1.0 / 255, 256, 256, 256};
+    std::vector<double> out(grid.columns * grid.rows);
+
+    for (auto _ : state)
+    {
+        akima.rasterize(grid, out.data());
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.counters["queries/s"] = benchmark::Counter(static_cast<double>(out.size()), benchmark::Counter::kIsIterationInvariantRate);
+    state.counters["bytes/point"] = static_cast<double>(akima.bytes()) / static_cast<double>(n);
+    state.SetComplexityN(static_cast<std::int64_t>(n));
+}
+
+#define BIVARIATE_BENCHMARK(name) \
+    BENCHMARK_TEMPLATE(name, uniform)->RangeMultiplier(10)->Range(1000, BIVARIATE_BENCHMARK_MAX_POINTS)->Unit(benchmark::kMillisecond); \
+    BENCHMARK_TEMPLATE(name, clustered)->RangeMultiplier(10)->Range(1000, BIVARIATE_BENCHMARK_MAX_POINTS)->Unit(benchmark::kMillisecond); \
+    BENCHMARK_TEMPLATE(name, gridded)->RangeMultiplier(10)->Range(1000, BIVARIATE_BENCHMARK_MAX_POINTS)->Unit(benchmark::kMillisecond); \
+    BENCHMARK_TEMPLATE(name, near_degenerate)->RangeMultiplier(10)->Range(1000, BIVARIATE_BENCHMARK_MAX_POINTS)->Unit(benchmark::kMillisecond)
+
+BIVARIATE_BENCHMARK(TriangulationBuild);
+BIVARIATE_BENCHMARK(TriangulationBuildPartitioned);
+BIVARIATE_BENCHMARK(AkimaFit);
+BIVARIATE_BENCHMARK(AkimaRefit);
+BIVARIATE_BENCHMARK(AkimaScalarEvaluation);
+BIVARIATE_BENCHMARK(LinearScalarEvaluation);
+BIVARIATE_BENCHMARK(NaturalNeighborScalarEvaluation);
+BIVARIATE_BENCHMARK(AkimaBatchedEvaluation);
+BIVARIATE_BENCHMARK(AkimaBatchedFloatEvaluation);
+BIVARIATE_BENCHMARK(AkimaBatchedHessianEvaluation);
+BIVARIATE_BENCHMARK(AkimaRasterize);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,120 @@
+//  (C) Copyright Matt Borland 2022.
+//  Use, modification and distribution are subject to the
+//  Boost Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <boost/math/constants/constants.hpp>
+#include <boost/math/interpolators/detail/triangulation.hpp>
+#include "allocation_counting.hpp"
+
+using boost::math::interpolators::polygonal_area;
+
+// Non-owning view, e.g. over a memory mapped file
+template <typename T>
+class view
+{
+public:
+    using value_type = T;
+
+    view(const T* data, std::size_t size) : data_ {data}, size_ {size} {}
+
+    const T* data() const { return data_; }
+    const T* begin() const { return data_; }
+    const T* end() const { return data_ + size_; }
+    std::size_t size() const { return size_; }
+
+private:
+    const T* data_;
+    std::size_t size_;
+};
+
+template <typename Real>
+void perturbed_circle(std::size_t n, std::vector<Real>& x, std::vector<Real>& y, std::vector<std::size_t>& nodes)
+{
+    std::mt19937_64 gen(87);
+    std::uniform_real_distribution<Real> dis(-0.01, 0.01);
+    x.resize(n);
+    y.resize(n);
+    nodes.resize(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const Real theta = 2 * boost::math::constants::pi<Real>() * static_cast<Real>(i) / static_cast<Real>(n);
+        x[i] = std::cos(theta) + dis(gen);
+        y[i] = std::sin(theta) + dis(gen);
+        nodes[i] = i;
+    }
+}
+
+template <typename Real, typename Summation = boost::math::interpolators::naive_summation>
+void PolygonalAreaContainer(benchmark::State& state)
+{
+    std::vector<Real> x, y;
+    std::vector<std::size_t> nodes;
+    perturbed_circle(static_cast<std::size_t>(state.range(0)), x, y, nodes);
+
+    const std::size_t start = allocations;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(polygonal_area(x, y, nodes, Summation()));
+    }
+    state.counters["allocations/call"] = benchmark::Counter(static_cast<double>(allocations - start),
+                                                            benchmark::Counter::kAvgIterations);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetComplexityN(state.range(0));
+}
+
+template <typename Real>
+void PolygonalAreaView(benchmark::State& state)
+{
+    std::vector<Real> x, y;
+    std::vector<std::size_t> nodes;
+    perturbed_circle(static_cast<std::size_t>(state.range(0)), x, y, nodes);
+    const view<Real> x_view(x.data(), x.size());
+    const view<Real> y_view(y.data(), y.size());
+    const view<std::size_t> nodes_view(nodes.data(), nodes.size());
+
+    const std::size_t start = allocations;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(polygonal_area(x_view, y_view, nodes_view));
+    }
+    state.counters["allocations/call"] = benchmark::Counter(static_cast<double>(allocations - start),
+                                                            benchmark::Counter::kAvgIterations);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetComplexityN(state.range(0));
+}
+
+template <typename Real>
+void PolygonalAreaVertices(benchmark::State& state)
+{
+    std::vector<Real> x, y;
+    std::vector<std::size_t> nodes;
+    perturbed_circle(static_cast<std::size_t>(state.range(0)), x, y, nodes);
+
+    const std::size_t start = allocations;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(polygonal_area(x.data(), x.data() + x.size(), y.data(), y.data() + y.size()));
+    }
+    state.counters["allocations/call"] = benchmark::Counter(static_cast<double>(allocations - start),
+                                                            benchmark::Counter::kAvgIterations);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK_TEMPLATE(PolygonalAreaContainer, float)->RangeMultiplier(8)->Range(1<<6, 1<<20)->Complexity();
+BENCHMARK_TEMPLATE(PolygonalAreaContainer, double)->RangeMultiplier(8)->Range(1<<6, 1<<20)->Complexity();
+BENCHMARK_TEMPLATE(PolygonalAreaContainer, float, boost::math::interpolators::compensated_summation)->RangeMultiplier(8)->Range(1<<6, 1<<20)->Complexity();
+BENCHMARK_TEMPLATE(PolygonalAreaContainer, double, boost::math::interpolators::compensated_summation)->RangeMultiplier(8)->Range(1<<6, 1<<20)->Complexity();
+BENCHMARK_TEMPLATE(PolygonalAreaContainer, double, boost::math::interpolators::pairwise_summation)->RangeMultiplier(8)->Range(1<<6, 1<<20)->Complexity();
+BENCHMARK_TEMPLATE(PolygonalAreaContainer, long double)->RangeMultiplier(8)->Range(1<<6, 1<<20)->Complexity();
+BENCHMARK_TEMPLATE(PolygonalAreaView, double)->RangeMultiplier(8)->Range(1<<6, 1<<20)->Complexity();
+BENCHMARK_TEMPLATE(PolygonalAreaVertices, float)->RangeMultiplier(8)->Range(1<<6, 1<<20)->Complexity();
+BENCHMARK_TEMPLATE(PolygonalAreaVertices, double)->RangeMultiplier(8)->Range(1<<6, 1<<20)->Complexity();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,171 @@
+//  (C) Copyright Matt Borland 2022.
+//  Use, modification and distribution are subject to the
+//  Boost Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/math/interpolators/bivariate_akima.hpp>
+#include <boost/math/interpolators/multichannel_bivariate_akima.hpp>
+#include <boost/math/interpolators/detail/akima_tables.hpp>
+#include <boost/math/interpolators/detail/thread_executor.hpp>
+#include "triangulation_checks.hpp"
+
+using boost::math::interpolators::bivariate_akima;
+using boost::math::interpolators::multichannel_bivariate_akima;
+using boost::math::interpolators::detail::evaluate_akima_tables;
+using boost::math::interpolators::detail::thread_executor;
+
+bool same_bits (double a, double b)
+{
+    return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+// Random queries over more than the convex hull, which lie off the edges by far more than the error
+// bound of the filter
+void random_queries (unsigned seed, std::size_t n, std::vector<double>& xs, std::vector<double>& ys)
+{
+    std::mt19937_64 gen(seed);
+    std::uniform_real_distribution<double> dist(-0.2, 1.2);
+    xs.resize(n);
+    ys.resize(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        xs[i] = dist(gen);
+        ys[i] = dist(gen);
+    }
+}
+
+std::vector<double> franke_values (const std::vector<double>& x, const std::vector<double>& y)
+{
+    std::vector<double> z(x.size());
+    for (std::size_t i = 0; i < x.size(); ++i)
+    {
+        const double a = 9 * x[i] - 2;
+        const double b = 9 * y[i] - 2;
+        z[i] = 0.75 * std::exp(-(a * a + b * b) / 4) + 0.5 * std::exp(-((9 * x[i] - 7) * (9 * x[i] - 7) + (9 * y[i] - 3) * (9 * y[i] - 3)) / 4) +
+               0.5 * std::exp(-((9 * x[i] - 4) * (9 * x[i] - 4) + (9 * y[i] - 7) * (9 * y[i] - 7)) / 4) - 0.2 * std::exp(-(a + 4) * (a + 4) - (b - 1) * (b - 1));
+    }
+    return z;
+}
+
+// Off the edges, the host backend is the interpolator bit for bit, with NaN outside of the convex hull,
+// whether the walks start from the seeds of the location grid or from the first triangle
+void test_scalar ()
+{
+    std::vector<double> x, y;
+    uniform_nodes(4000, 29, x, y);
+    std::vector<double> z = franke_values(x, y);
+    bivariate_akima<std::vector<double>> akima {std::move(x), std::move(y), std::move(z)};
+
+    std::vector<double> xs, ys;
+    random_queries(30, 20000, xs, ys);
+    std::vector<double> out(xs.size());
+    for (const bool indexed : {false, true})
+    {
+        if (indexed)
+        {
+            akima.index_locations();
+        }
+        evaluate_akima_tables(akima.tables(), xs.data(), ys.data(), out.data(), xs.size(), thread_executor(2));
+        std::size_t different = 0;
+        for (std::size_t i = 0; i < xs.size(); ++i)
+        {
+            different += same_bits(out[i], akima(xs[i], ys[i])) ? 0 : 1;
+        }
+        BOOST_TEST_EQ(different, 0u);
+    }
+}
+
+// At the midpoints of the edges the kernel may pick the triangle on the other side, whose quintic agrees
+// along the edge to rounding
+void test_edges ()
+{
+    std::vector<double> x, y;
+    uniform_nodes(2000, 31, x, y);
+    std::vector<double> z = franke_values(x, y);
+    bivariate_akima<std::vector<double>> akima {std::move(x), std::move(y), std::move(z)};
+    akima.index_locations();
+    const auto tables = akima.tables();
+
+    std::vector<double> xs, ys;
+    for (std::uint32_t t = 0; t < tables.triangles; ++t)
+    {
+        const std::uint32_t* v = tables.vertices + 3 * t;
+        if (v[2] == static_cast<std::uint32_t>(-1))
+        {
+            continue;
+        }
+        for (int i = 0; i < 3; ++i)
+        {
+            xs.push_back((tables.x[v[i]] + tables.x[v[(i + 1) % 3]]) / 2);
+            ys.push_back((tables.y[v[i]] + tables.y[v[(i + 1) % 3]]) / 2);
+        }
+    }
+    std::vector<double> out(xs.size());
+    evaluate_akima_tables(tables, xs.data(), ys.data(), out.data(), xs.size());
+    double worst = 0;
+    for (std::size_t i = 0; i < xs.size(); ++i)
+    {
+        worst = (std::max)(worst, std::abs(out[i] - akima(xs[i], ys[i])));
+    }
+    BOOST_TEST_LT(worst, 1e-14);
+}
+
+// The channels are evaluated together, and from tables uploaded to memory owned elsewhere
+void test_multichannel_upload ()
+{
+    constexpr std::size_t channels = 2;
+    std::vector<double> x, y;
+    uniform_nodes(3000, 32, x, y);
+    std::vector<double> z(channels * x.size());
+    for (std::size_t i = 0; i < x.size(); ++i)
+    {
+        z[channels * i] = std::sin(3 * x[i]) * y[i];
+        z[channels * i + 1] = x[i] * x[i] - y[i];
+    }
+    multichannel_bivariate_akima<std::vector<double>> akima {std::move(x), std::move(y), std::move(z), channels};
+    akima.index_locations();
+
+    std::vector<std::unique_ptr<char[]>> device;
+    std::size_t copied = 0;
+    const auto tables = akima.tables().upload([&](const void* source, std::size_t bytes)
+    {
+        device.emplace_back(new char[bytes]);
+        std::memcpy(device.back().get(), source, bytes);
+        copied += bytes;
+        return static_cast<const void*>(device.back().get());
+    });
+    BOOST_TEST_EQ(copied, akima.tables().bytes());
+
+    std::vector<double> xs, ys;
+    random_queries(33, 10000, xs, ys);
+    std::vector<double> out(channels * xs.size());
+    evaluate_akima_tables(tables, xs.data(), ys.data(), out.data(), xs.size());
+    std::vector<double> expected(channels);
+    std::size_t different = 0;
+    for (std::size_t i = 0; i < xs.size(); ++i)
+    {
+        akima(xs[i], ys[i], expected);
+        for (std::size_t c = 0; c < channels; ++c)
+        {
+            different += same_bits(out[channels * i + c], expected[c]) ? 0 : 1;
+        }
+    }
+    BOOST_TEST_EQ(different, 0u);
+}
+
+int main ()
+{
+    test_scalar();
+    test_edges();
+    test_multichannel_upload();
+    return boost::report_errors();
+}
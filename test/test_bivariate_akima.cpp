@@ -0,0 +1,80 @@
+//  (C) Copyright Matt Borland 2022.
+//  Use, modification and distribution are subject to the
+//  Boost Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <vector>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/math/interpolators/bivariate_akima.hpp>
+#include "triangulation_checks.hpp"
+
+using boost::math::interpolators::bivariate_akima;
+
+double cubic (double x, double y)
+{
+    return 1 - 2 * x + 3 * y + x * x - 4 * x * y + 2 * y * y + 5 * x * x * x - x * x * y + 3 * x * y * y - 2 * y * y * y;
+}
+
+// The surface passes through the values at the nodes
+void test_interpolates ()
+{
+    std::vector<double> x, y;
+    uniform_nodes(2000, 13, x, y);
+    std::vector<double> z(x.size());
+    for (std::size_t i = 0; i < x.size(); ++i)
+    {
+        z[i] = std::sin(4 * x[i]) * std::cos(3 * y[i]) + x[i];
+    }
+    const std::vector<double> nx = x;
+    const std::vector<double> ny = y;
+    const std::vector<double> nz = z;
+    const bivariate_akima<std::vector<double>> akima {std::move(x), std::move(y), std::move(z)};
+
+    double worst = 0;
+    for (std::size_t i = 0; i < nx.size(); ++i)
+    {
+        worst = (std::max)(worst, std::abs(akima(nx[i], ny[i]) - nz[i]));
+    }
+    BOOST_TEST_LT(worst, 1e-14);
+}
+
+// The least squares cubics of the derivatives are exact for a cubic, and the quintics then reproduce it
+// everywhere in the convex hull, whether the walks start from the thread's hint or from one given
+void test_reproduces_cubic ()
+{
+    std::vector<double> x, y;
+    uniform_nodes(3000, 14, x, y);
+    std::vector<double> z(x.size());
+    for (std::size_t i = 0; i < x.size(); ++i)
+    {
+        z[i] = cubic(x[i], y[i]);
+    }
+    const bivariate_akima<std::vector<double>> akima {std::move(x), std::move(y), std::move(z)};
+
+    std::mt19937_64 gen(15);
+    std::uniform_real_distribution<double> dist(0.05, 0.95);
+    bivariate_akima<std::vector<double>>::hint_type hint;
+    double worst = 0;
+    std::size_t different = 0;
+    for (int q = 0; q < 20000; ++q)
+    {
+        const double qx = dist(gen);
+        const double qy = dist(gen);
+        const double value = akima(qx, qy);
+        worst = (std::max)(worst, std::abs(value - cubic(qx, qy)));
+        different += akima(qx, qy, hint) == value ? 0 : 1;
+    }
+    BOOST_TEST_LT(worst, 1e-12);
+    BOOST_TEST_EQ(different, 0u);
+}
+
+int main ()
+{
+    test_interpolates();
+    test_reproduces_cubic();
+    return boost::report_errors();
+}
@@ -0,0 +1,150 @@
+//  (C) Copyright Matt Borland 2022.
+//  Use, modification and distribution are subject to the
+//  Boost Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/math/interpolators/bivariate_akima.hpp>
+#include "triangulation_checks.hpp"
+
+using boost::math::interpolators::bivariate_akima;
+
+using akima_type = bivariate_akima<std::vector<double>>;
+
+// Equal, or both NaN as outside of the convex hull
+bool same (double a, double b)
+{
+    return a == b || (std::isnan(a) && std::isnan(b));
+}
+
+akima_type make_akima ()
+{
+    std::vector<double> x, y;
+    uniform_nodes(1500, 16, x, y);
+    std::vector<double> z(x.size());
+    for (std::size_t i = 0; i < x.size(); ++i)
+    {
+        z[i] = std::exp(-2 * x[i]) * std::sin(5 * y[i]) + x[i] * y[i] * y[i];
+    }
+    return akima_type {std::move(x), std::move(y), std::move(z)};
+}
+
+// The centroids of the triangles away from the convex hull whose edges are farther than reach from
+// them, so that differences with steps up to reach stay on one quintic. Along the hull, and in slivers,
+// the quintics bend sharply enough that the differences need far shorter steps.
+std::vector<std::array<double, 2>> centroids (const akima_type& akima, double reach)
+{
+    const auto tables = akima.tables();
+    std::vector<std::array<double, 2>> result;
+    for (std::uint32_t t = 0; t < tables.triangles; ++t)
+    {
+        const std::uint32_t* v = tables.vertices + 3 * t;
+        if (v[2] == static_cast<std::uint32_t>(-1))
+        {
+            continue;
+        }
+        const double cx = (tables.x[v[0]] + tables.x[v[1]] + tables.x[v[2]]) / 3;
+        const double cy = (tables.y[v[0]] + tables.y[v[1]] + tables.y[v[2]]) / 3;
+        bool inside = true;
+        for (int i = 0; i < 3; ++i)
+        {
+            const double ax = tables.x[v[i]];
+            const double ay = tables.y[v[i]];
+            const double bx = tables.x[v[(i + 1) % 3]];
+            const double by = tables.y[v[(i + 1) % 3]];
+            const double distance = std::abs((bx - ax) * (cy - ay) - (by - ay) * (cx - ax)) / std::hypot(bx - ax, by - ay);
+            inside = inside && distance > reach;
+        }
+        if (inside && cx > 0.1 && cx < 0.9 && cy > 0.1 && cy < 0.9)
+        {
+            result.push_back({{cx, cy}});
+        }
+    }
+    return result;
+}
+
+// The value is that of operator() and the gradient that of value_and_gradient, bit for bit, and the
+// batches are the scalar evaluations
+void test_consistent ()
+{
+    const akima_type akima = make_akima();
+    std::vector<double> xs, ys;
+    uniform_nodes(5000, 17, xs, ys);
+
+    std::size_t values = 0;
+    std::size_t gradients = 0;
+    for (std::size_t q = 0; q < xs.size(); ++q)
+    {
+        const std::array<double, 3> g = akima.value_and_gradient(xs[q], ys[q]);
+        const std::array<double, 6> h = akima.value_gradient_hessian(xs[q], ys[q]);
+        values += (same(h[0], akima(xs[q], ys[q])) && same(g[0], h[0])) ? 0 : 1;
+        gradients += (same(g[1], h[1]) && same(g[2], h[2])) ? 0 : 1;
+    }
+    BOOST_TEST_EQ(values, 0u);
+    BOOST_TEST_EQ(gradients, 0u);
+
+    std::vector<double> batch(6 * xs.size());
+    akima.evaluate_value_gradient_hessian(xs, ys, batch);
+    std::vector<double> gradient_batch(3 * xs.size());
+    akima.evaluate_value_and_gradient(xs, ys, gradient_batch);
+    std::size_t different = 0;
+    for (std::size_t q = 0; q < xs.size(); ++q)
+    {
+        const std::array<double, 6> h = akima.value_gradient_hessian(xs[q], ys[q]);
+        for (std::size_t i = 0; i < 6; ++i)
+        {
+            different += same(batch[6 * q + i], h[i]) ? 0 : 1;
+        }
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            different += same(gradient_batch[3 * q + i], h[i]) ? 0 : 1;
+        }
+    }
+    BOOST_TEST_EQ(different, 0u);
+}
+
+// Central differences of the value and the gradient inside of the triangles give the gradient and the
+// Hessian, to the square of the step
+void test_finite_differences ()
+{
+    const akima_type akima = make_akima();
+    const double step = 1e-6;
+    const std::vector<std::array<double, 2>> points = centroids(akima, 1e-3);
+    BOOST_TEST_GT(points.size(), 1000u);
+
+    double gradient_error = 0;
+    double hessian_error = 0;
+    for (const auto& p : points)
+    {
+        const std::array<double, 6> h = akima.value_gradient_hessian(p[0], p[1]);
+        const double zx = (akima(p[0] + step, p[1]) - akima(p[0] - step, p[1])) / (2 * step);
+        const double zy = (akima(p[0], p[1] + step) - akima(p[0], p[1] - step)) / (2 * step);
+        gradient_error = (std::max)(gradient_error, (std::max)(std::abs(zx - h[1]), std::abs(zy - h[2])));
+
+        const std::array<double, 3> east = akima.value_and_gradient(p[0] + step, p[1]);
+        const std::array<double, 3> west = akima.value_and_gradient(p[0] - step, p[1]);
+        const std::array<double, 3> north = akima.value_and_gradient(p[0], p[1] + step);
+        const std::array<double, 3> south = akima.value_and_gradient(p[0], p[1] - step);
+        const double zxx = (east[1] - west[1]) / (2 * step);
+        const double zxy = (north[1] - south[1]) / (2 * step);
+        const double zyx = (east[2] - west[2]) / (2 * step);
+        const double zyy = (north[2] - south[2]) / (2 * step);
+        hessian_error = (std::max)(hessian_error, (std::max)(std::abs(zxx - h[3]), std::abs(zyy - h[5])));
+        hessian_error = (std::max)(hessian_error, (std::max)(std::abs(zxy - h[4]), std::abs(zyx - h[4])));
+    }
+    BOOST_TEST_LT(gradient_error, 1e-8);
+    BOOST_TEST_LT(hessian_error, 1e-5);
+}
+
+int main ()
+{
+    test_consistent();
+    test_finite_differences();
+    return boost::report_errors();
+}
@@ -0,0 +1,126 @@
+//  (C) Copyright Matt Borland 2022.
+//  Use, modification and distribution are subject to the
+//  Boost Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <random>
+#include <vector>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/math/interpolators/bivariate_akima.hpp>
+#include <boost/math/interpolators/detail/triangulation.hpp>
+#include "triangulation_checks.hpp"
+
+using boost::math::interpolators::bivariate_akima;
+using boost::math::interpolators::detail::triangulation;
+
+double f (double x, double y)
+{
+    return std::exp(-x * y) * std::sin(4 * x + 3 * y);
+}
+
+// Removes node v as remove_node does, moving the last node into its place
+void erase_node (std::vector<double>& v, std::size_t i)
+{
+    v[i] = v.back();
+    v.pop_back();
+}
+
+// Nodes inserted inside and outside of the hull and erased at random give the triangulation of the
+// nodes that remain
+void test_triangulation ()
+{
+    std::vector<double> x, y;
+    uniform_nodes(2000, 4, x, y);
+    triangulation<double> tri(x, y);
+
+    std::mt19937_64 gen(5);
+    std::uniform_real_distribution<double> dist(-0.25, 1.25);
+    std::vector<std::size_t> changed;
+    for (int k = 0; k < 1000; ++k)
+    {
+        if (k % 3 == 2)
+        {
+            const std::size_t v = gen() % x.size();
+            tri.remove_node(static_cast<triangulation<double>::index_type>(v), std::back_inserter(changed));
+            erase_node(x, v);
+            erase_node(y, v);
+        }
+        else
+        {
+            x.push_back(dist(gen));
+            y.push_back(dist(gen));
+            tri.add_node(x.back(), y.back());
+        }
+    }
+
+    check_delaunay(tri);
+    BOOST_TEST(triangle_set(tri) == triangle_set(triangulation<double>(x, y)));
+}
+
+// The interpolator updated by insert and erase, with a location index that they age and rebuild,
+// evaluates as the one built from scratch on the same nodes, up to rounding
+void test_interpolator ()
+{
+    std::vector<double> x, y;
+    uniform_nodes(3000, 6, x, y);
+    std::vector<double> z(x.size());
+    for (std::size_t i = 0; i < x.size(); ++i)
+    {
+        z[i] = f(x[i], y[i]);
+    }
+    bivariate_akima<std::vector<double>> updated {std::vector<double>(x), std::vector<double>(y), std::vector<double>(z)};
+    updated.index_locations();
+
+    std::mt19937_64 gen(7);
+    std::uniform_real_distribution<double> dist(-0.25, 1.25);
+    for (int k = 0; k < 1000; ++k)
+    {
+        if (k % 2 == 1)
+        {
+            const std::size_t v = gen() % x.size();
+            updated.erase(v);
+            erase_node(x, v);
+            erase_node(y, v);
+            erase_node(z, v);
+        }
+        else
+        {
+            x.push_back(dist(gen));
+            y.push_back(dist(gen));
+            z.push_back(f(x.back(), y.back()));
+            BOOST_TEST_EQ(updated.insert(x.back(), y.back(), z.back()), x.size() - 1);
+        }
+    }
+    const bivariate_akima<std::vector<double>> rebuilt {std::move(x), std::move(y), std::move(z)};
+
+    std::uniform_real_distribution<double> query(-0.3, 1.3);
+    std::size_t nan_mismatches = 0;
+    double worst = 0;
+    for (int q = 0; q < 20000; ++q)
+    {
+        const double qx = query(gen);
+        const double qy = query(gen);
+        const double a = updated(qx, qy);
+        const double b = rebuilt(qx, qy);
+        if (std::isnan(a) != std::isnan(b))
+        {
+            ++nan_mismatches;
+        }
+        else if (!std::isnan(a))
+        {
+            worst = (std::max)(worst, std::abs(a - b));
+        }
+    }
+    BOOST_TEST_EQ(nan_mismatches, 0u);
+    BOOST_TEST_LT(worst, 1e-12);
+}
+
+int main ()
+{
+    test_triangulation();
+    test_interpolator();
+    return boost::report_errors();
+}
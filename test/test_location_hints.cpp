@@ -0,0 +1,75 @@
+//  (C) Copyright Matt Borland 2022.
+//  Use, modification and distribution are subject to the
+//  Boost Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/math/interpolators/bivariate_akima.hpp>
+#include "triangulation_checks.hpp"
+
+using boost::math::interpolators::bivariate_akima;
+using boost::math::interpolators::collect_statistics;
+using interpolator = bivariate_akima<std::vector<double>, std::uint32_t, collect_statistics>;
+
+interpolator make_interpolator (unsigned seed)
+{
+    std::vector<double> x, y;
+    uniform_nodes(20000, seed, x, y);
+    std::vector<double> z(x.size());
+    for (std::size_t i = 0; i < x.size(); ++i)
+    {
+        z[i] = std::sin(3 * x[i]) + y[i];
+    }
+    return interpolator {std::move(x), std::move(y), std::move(z)};
+}
+
+// A thread alternating between two interpolators along scan lines walks as little as if it queried
+// one, and finds the triangles that explicit hints find
+void test_alternating ()
+{
+    interpolator a = make_interpolator(13);
+    interpolator b = make_interpolator(14);
+    interpolator::hint_type hint_a;
+    interpolator::hint_type hint_b;
+    a.reset_statistics();
+    b.reset_statistics();
+    std::size_t different = 0;
+    for (int i = 0; i < 100000; ++i)
+    {
+        const double t = 0.01 + 0.98 * i / 100000;
+        const double u = a(t, 0.3);
+        const double v = b(t, 0.7);
+        const double u_hinted = a(t, 0.3, hint_a);
+        const double v_hinted = b(t, 0.7, hint_b);
+        different += std::memcmp(&u, &u_hinted, sizeof(double)) == 0 ? 0 : 1;
+        different += std::memcmp(&v, &v_hinted, sizeof(double)) == 0 ? 0 : 1;
+    }
+    BOOST_TEST_EQ(different, 0u);
+    BOOST_TEST_LT(a.statistics().triangulation.mean_walk(), 0.1);
+    BOOST_TEST_LT(b.statistics().triangulation.mean_walk(), 0.1);
+}
+
+// The hint of the thread does not survive the erasure of a node, whose removal renumbers triangles
+void test_after_erase ()
+{
+    interpolator a = make_interpolator(15);
+    const double before = a(0.5, 0.5);
+    for (std::size_t v = 0; v < 100; ++v)
+    {
+        a.erase(v);
+    }
+    BOOST_TEST(std::isfinite(a(0.5, 0.5)));
+    BOOST_TEST_LT(std::abs(a(0.5, 0.5) - before), 0.1);
+}
+
+int main ()
+{
+    test_alternating();
+    test_after_erase();
+    return boost::report_errors();
+}
@@ -0,0 +1,138 @@
+//  (C) Copyright Matt Borland 2022.
+//  Use, modification and distribution are subject to the
+//  Boost Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <boost/align/aligned_allocator.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/math/interpolators/bivariate_akima.hpp>
+#include <boost/math/interpolators/mapped_bivariate_akima.hpp>
+#include <boost/math/interpolators/multichannel_bivariate_akima.hpp>
+#include "triangulation_checks.hpp"
+
+using boost::math::interpolators::bivariate_akima;
+using boost::math::interpolators::mapped_bivariate_akima;
+using boost::math::interpolators::multichannel_bivariate_akima;
+
+// The image in memory aligned as a mapping would be
+using image_buffer = std::vector<char, boost::alignment::aligned_allocator<char, 64>>;
+
+template <class Interpolator>
+image_buffer save (const Interpolator& interpolator)
+{
+    std::ostringstream os(std::ios::binary);
+    interpolator.save(os);
+    const std::string image = os.str();
+    return image_buffer(image.begin(), image.end());
+}
+
+bool same_bits (double a, double b)
+{
+    return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+// The mapped image of an indexed interpolator evaluates as the interpolator, bit for bit, inside and
+// outside of the convex hull
+void test_scalar ()
+{
+    std::vector<double> x, y;
+    uniform_nodes(5000, 8, x, y);
+    std::vector<double> z(x.size());
+    for (std::size_t i = 0; i < x.size(); ++i)
+    {
+        z[i] = std::cos(5 * x[i] - 2 * y[i]) + x[i] * y[i];
+    }
+    bivariate_akima<std::vector<double>> akima {std::move(x), std::move(y), std::move(z)};
+    akima.index_locations();
+
+    const image_buffer image = save(akima);
+    const mapped_bivariate_akima<double> mapped(image.data(), image.size());
+    BOOST_TEST_EQ(mapped.channels(), 1u);
+
+    std::mt19937_64 gen(9);
+    std::uniform_real_distribution<double> dist(-0.2, 1.2);
+    std::size_t values = 0;
+    std::size_t derivatives = 0;
+    for (int q = 0; q < 20000; ++q)
+    {
+        const double qx = dist(gen);
+        const double qy = dist(gen);
+        values += same_bits(mapped(qx, qy), akima(qx, qy)) ? 0 : 1;
+        const std::array<double, 6> a = mapped.value_gradient_hessian(qx, qy);
+        const std::array<double, 6> b = akima.value_gradient_hessian(qx, qy);
+        for (std::size_t i = 0; i < a.size(); ++i)
+        {
+            derivatives += same_bits(a[i], b[i]) ? 0 : 1;
+        }
+    }
+    BOOST_TEST_EQ(values, 0u);
+    BOOST_TEST_EQ(derivatives, 0u);
+}
+
+void test_multichannel ()
+{
+    constexpr std::size_t channels = 3;
+    std::vector<double> x, y;
+    uniform_nodes(3000, 10, x, y);
+    std::vector<double> z(channels * x.size());
+    for (std::size_t i = 0; i < x.size(); ++i)
+    {
+        z[channels * i] = x[i] - y[i];
+        z[channels * i + 1] = std::sin(3 * x[i]);
+        z[channels * i + 2] = std::exp(x[i] * y[i]);
+    }
+    multichannel_bivariate_akima<std::vector<double>> akima {std::move(x), std::move(y), std::move(z), channels};
+    akima.index_locations(2);
+
+    const image_buffer image = save(akima);
+    const mapped_bivariate_akima<double> mapped(image.data(), image.size());
+    BOOST_TEST_EQ(mapped.channels(), channels);
+
+    std::mt19937_64 gen(11);
+    std::uniform_real_distribution<double> dist(-0.2, 1.2);
+    std::array<double, channels> a;
+    std::array<double, channels> b;
+    std::size_t different = 0;
+    for (int q = 0; q < 10000; ++q)
+    {
+        const double qx = dist(gen);
+        const double qy = dist(gen);
+        mapped(qx, qy, a);
+        akima(qx, qy, b);
+        for (std::size_t c = 0; c < channels; ++c)
+        {
+            different += same_bits(a[c], b[c]) ? 0 : 1;
+        }
+    }
+    BOOST_TEST_EQ(different, 0u);
+}
+
+// An image is rejected for another Real, and when it is cut short
+void test_rejected ()
+{
+    std::vector<double> x, y;
+    uniform_nodes(100, 12, x, y);
+    std::vector<double> z(x);
+    bivariate_akima<std::vector<double>> akima {std::move(x), std::move(y), std::move(z)};
+    const image_buffer image = save(akima);
+
+    BOOST_TEST_THROWS(mapped_bivariate_akima<float>(image.data(), image.size()), std::domain_error);
+    BOOST_TEST_THROWS(mapped_bivariate_akima<double>(image.data(), image.size() - 1), std::domain_error);
+}
+
+int main ()
+{
+    test_scalar();
+    test_multichannel();
+    test_rejected();
+    return boost::report_errors();
+}
@@ -0,0 +1,148 @@
+//  (C) Copyright Matt Borland 2022.
+//  Use, modification and distribution are subject to the
+//  Boost Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/math/interpolators/bivariate_akima.hpp>
+#include <boost/math/interpolators/multichannel_bivariate_akima.hpp>
+#include "triangulation_checks.hpp"
+
+using boost::math::interpolators::bivariate_akima;
+using boost::math::interpolators::multichannel_bivariate_akima;
+
+constexpr std::size_t channels = 3;
+
+bool same_bits (double a, double b)
+{
+    return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+double field (std::size_t c, double x, double y, double time)
+{
+    switch (c)
+    {
+    case 0:
+        return std::sin(4 * x + time) * y;
+    case 1:
+        return std::exp(-x * y) + time * x;
+    default:
+        return x * x - y * y * time;
+    }
+}
+
+// The values of the channels at the nodes, interleaved, and of channel c alone
+std::vector<double> interleaved (const std::vector<double>& x, const std::vector<double>& y, double time)
+{
+    std::vector<double> z(channels * x.size());
+    for (std::size_t i = 0; i < x.size(); ++i)
+    {
+        for (std::size_t c = 0; c < channels; ++c)
+        {
+            z[channels * i + c] = field(c, x[i], y[i], time);
+        }
+    }
+    return z;
+}
+
+std::vector<double> single (const std::vector<double>& x, const std::vector<double>& y, std::size_t c, double time)
+{
+    std::vector<double> z(x.size());
+    for (std::size_t i = 0; i < x.size(); ++i)
+    {
+        z[i] = field(c, x[i], y[i], time);
+    }
+    return z;
+}
+
+// Each channel, with its derivatives, is bit for bit the interpolator of that channel alone, inside and
+// outside of the convex hull
+template <class Multichannel>
+void check_channels (const Multichannel& multichannel, const std::vector<bivariate_akima<std::vector<double>>>& akimas)
+{
+    std::mt19937_64 gen(27);
+    std::uniform_real_distribution<double> dist(-0.1, 1.1);
+    std::array<double, channels> values;
+    std::array<double, 6 * channels> derivatives;
+    std::size_t different = 0;
+    for (int q = 0; q < 10000; ++q)
+    {
+        const double qx = dist(gen);
+        const double qy = dist(gen);
+        multichannel(qx, qy, values);
+        multichannel.value_gradient_hessian(qx, qy, derivatives);
+        for (std::size_t c = 0; c < channels; ++c)
+        {
+            different += same_bits(values[c], akimas[c](qx, qy)) ? 0 : 1;
+            const std::array<double, 6> h = akimas[c].value_gradient_hessian(qx, qy);
+            for (std::size_t i = 0; i < 6; ++i)
+            {
+                different += same_bits(derivatives[6 * c + i], h[i]) ? 0 : 1;
+            }
+        }
+    }
+    BOOST_TEST_EQ(different, 0u);
+}
+
+// The channels fitted together, and refitted with the values of a later time step on the same nodes
+void test_single_channels ()
+{
+    std::vector<double> x, y;
+    uniform_nodes(2500, 26, x, y);
+
+    std::vector<bivariate_akima<std::vector<double>>> akimas;
+    for (std::size_t c = 0; c < channels; ++c)
+    {
+        akimas.emplace_back(std::vector<double>(x), std::vector<double>(y), single(x, y, c, 0));
+    }
+    multichannel_bivariate_akima<std::vector<double>> multichannel {std::vector<double>(x), std::vector<double>(y), interleaved(x, y, 0), channels};
+    BOOST_TEST_EQ(multichannel.channels(), channels);
+    check_channels(multichannel, akimas);
+
+    for (std::size_t c = 0; c < channels; ++c)
+    {
+        akimas[c].refit(single(x, y, c, 1));
+    }
+    multichannel.refit(interleaved(x, y, 1));
+    check_channels(multichannel, akimas);
+
+    // A refit gives the interpolator fitted from scratch on the new values
+    std::size_t different = 0;
+    const bivariate_akima<std::vector<double>> scratch {std::vector<double>(x), std::vector<double>(y), single(x, y, 1, 1)};
+    for (std::size_t i = 0; i + 1 < x.size(); i += 7)
+    {
+        const double qx = (x[i] + x[i + 1]) / 2;
+        const double qy = (y[i] + y[i + 1]) / 2;
+        different += same_bits(akimas[1](qx, qy), scratch(qx, qy)) ? 0 : 1;
+    }
+    BOOST_TEST_EQ(different, 0u);
+}
+
+// The values must come in whole sets of channels, and the outputs must match the channels
+void test_rejected ()
+{
+    std::vector<double> x, y;
+    uniform_nodes(50, 28, x, y);
+    std::vector<double> z = interleaved(x, y, 0);
+    z.pop_back();
+    BOOST_TEST_THROWS((multichannel_bivariate_akima<std::vector<double>> {std::vector<double>(x), std::vector<double>(y), std::move(z), channels}),
+                      std::domain_error);
+
+    const multichannel_bivariate_akima<std::vector<double>> multichannel {std::vector<double>(x), std::vector<double>(y), interleaved(x, y, 0), channels};
+    std::vector<double> out(channels + 1);
+    BOOST_TEST_THROWS(multichannel(0.5, 0.5, out), std::domain_error);
+}
+
+int main ()
+{
+    test_single_channels();
+    test_rejected();
+    return boost::report_errors();
+}
@@ -0,0 +1,137 @@
+//  (C) Copyright Matt Borland 2022.
+//  Use, modification and distribution are subject to the
+//  Boost Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <vector>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/math/interpolators/bivariate_akima.hpp>
+#include "triangulation_checks.hpp"
+
+using boost::math::interpolators::bivariate_akima;
+
+using akima_type = bivariate_akima<std::vector<double>>;
+
+template <class F>
+akima_type make_akima (unsigned seed, F f)
+{
+    std::vector<double> x, y;
+    uniform_nodes(2000, seed, x, y);
+    std::vector<double> z(x.size());
+    for (std::size_t i = 0; i < x.size(); ++i)
+    {
+        z[i] = f(x[i], y[i]);
+    }
+    return akima_type {std::move(x), std::move(y), std::move(z)};
+}
+
+// The queries, inside of the convex hull and about its boundary
+std::vector<double> queries (unsigned seed)
+{
+    std::mt19937_64 gen(seed);
+    std::uniform_real_distribution<double> dist(-0.05, 1.05);
+    std::vector<double> q(2 * 20000);
+    for (double& c : q)
+    {
+        c = dist(gen);
+    }
+    return q;
+}
+
+// The weights of both evaluators sum to 1: constant values come back to within a few ulps, and NaN is
+// returned exactly where operator() returns it
+void test_partition_of_unity ()
+{
+    const akima_type akima = make_akima(19, [](double, double) { return 3.0; });
+    const std::vector<double> q = queries(20);
+    double linear = 0;
+    double sibson = 0;
+    std::size_t hull = 0;
+    for (std::size_t k = 0; k < q.size(); k += 2)
+    {
+        const bool outside = std::isnan(akima(q[k], q[k + 1]));
+        const double a = akima.linear(q[k], q[k + 1]);
+        const double b = akima.natural_neighbor(q[k], q[k + 1]);
+        hull += (std::isnan(a) == outside && std::isnan(b) == outside) ? 0 : 1;
+        if (!outside)
+        {
+            linear = (std::max)(linear, std::abs(a - 3));
+            sibson = (std::max)(sibson, std::abs(b - 3));
+        }
+    }
+    BOOST_TEST_EQ(hull, 0u);
+    BOOST_TEST_LT(linear, 1e-14);
+    BOOST_TEST_LT(sibson, 1e-13);
+}
+
+// Both are exact for linear values, inside of the hull and on its boundary
+void test_linear_precision ()
+{
+    auto plane = [](double x, double y) { return 2 - 3 * x + 5 * y; };
+    const akima_type akima = make_akima(21, plane);
+    const std::vector<double> q = queries(22);
+    double linear = 0;
+    double sibson = 0;
+    for (std::size_t k = 0; k < q.size(); k += 2)
+    {
+        const double a = akima.linear(q[k], q[k + 1]);
+        const double b = akima.natural_neighbor(q[k], q[k + 1]);
+        if (!std::isnan(a))
+        {
+            linear = (std::max)(linear, std::abs(a - plane(q[k], q[k + 1])));
+            sibson = (std::max)(sibson, std::abs(b - plane(q[k], q[k + 1])));
+        }
+    }
+    BOOST_TEST_LT(linear, 1e-13);
+    BOOST_TEST_LT(sibson, 1e-12);
+}
+
+// The weights are not negative: the values are convex combinations of those of the nodes, and they
+// pass through the values at the nodes
+void test_convex ()
+{
+    std::vector<double> x, y;
+    uniform_nodes(2000, 23, x, y);
+    std::mt19937_64 gen(24);
+    std::uniform_real_distribution<double> dist(-1, 1);
+    std::vector<double> z(x.size());
+    for (double& v : z)
+    {
+        v = dist(gen);
+    }
+    const std::vector<double> nx = x;
+    const std::vector<double> ny = y;
+    const std::vector<double> nz = z;
+    const double low = *std::min_element(nz.begin(), nz.end());
+    const double high = *std::max_element(nz.begin(), nz.end());
+    const akima_type akima {std::move(x), std::move(y), std::move(z)};
+
+    const std::vector<double> q = queries(25);
+    std::size_t outside = 0;
+    for (std::size_t k = 0; k < q.size(); k += 2)
+    {
+        const double b = akima.natural_neighbor(q[k], q[k + 1]);
+        outside += (std::isnan(b) || (b >= low - 1e-14 && b <= high + 1e-14)) ? 0 : 1;
+    }
+    BOOST_TEST_EQ(outside, 0u);
+
+    double at_nodes = 0;
+    for (std::size_t i = 0; i < nx.size(); ++i)
+    {
+        at_nodes = (std::max)(at_nodes, std::abs(akima.natural_neighbor(nx[i], ny[i]) - nz[i]));
+        at_nodes = (std::max)(at_nodes, std::abs(akima.linear(nx[i], ny[i]) - nz[i]));
+    }
+    BOOST_TEST_LT(at_nodes, 1e-14);
+}
+
+int main ()
+{
+    test_partition_of_unity();
+    test_linear_precision();
+    test_convex();
+    return boost::report_errors();
+}
@@ -0,0 +1,104 @@
+//  (C) Copyright Matt Borland 2022.
+//  Use, modification and distribution are subject to the
+//  Boost Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <random>
+#include <vector>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/math/interpolators/bivariate_akima.hpp>
+#include <boost/math/interpolators/detail/thread_executor.hpp>
+#include <boost/math/interpolators/detail/triangulation.hpp>
+#include "triangulation_checks.hpp"
+
+using boost::math::interpolators::bivariate_akima;
+using boost::math::interpolators::detail::sequential_executor;
+using boost::math::interpolators::detail::thread_executor;
+using boost::math::interpolators::detail::triangulation;
+
+// Enough nodes for a partition of several cells of 2^16 nodes
+constexpr std::size_t nodes = 300000;
+
+template <class Triangulation>
+bool same_arrays (const Triangulation& a, const Triangulation& b)
+{
+    if (a.triangle_count() != b.triangle_count())
+    {
+        return false;
+    }
+    for (typename Triangulation::index_type t = 0; t < a.triangle_count(); ++t)
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            if (a.vertex(t, i) != b.vertex(t, i) || a.neighbor(t, i) != b.neighbor(t, i))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// The partitioned construction gives the serial Delaunay triangulation of nodes in general position,
+// and the same arrays whatever the executor and its number of threads
+void test_triangulation ()
+{
+    std::vector<double> x, y;
+    uniform_nodes(nodes, 1, x, y);
+
+    const triangulation<double> serial(x, y);
+    const triangulation<double> one(x, y, thread_executor(1));
+    const triangulation<double> four(x, y, thread_executor(4));
+    const triangulation<double> inline_tasks(x, y, sequential_executor());
+
+    check_delaunay(four);
+    BOOST_TEST(triangle_set(serial) == triangle_set(four));
+    BOOST_TEST(same_arrays(one, four));
+    BOOST_TEST(same_arrays(inline_tasks, four));
+}
+
+// The interpolators built on executors agree bit for bit, and with the serial one up to rounding
+void test_interpolator ()
+{
+    std::vector<double> x, y;
+    uniform_nodes(nodes, 2, x, y);
+    std::vector<double> z(nodes);
+    for (std::size_t i = 0; i < nodes; ++i)
+    {
+        z[i] = std::sin(6 * x[i]) * std::cos(5 * y[i]);
+    }
+
+    bivariate_akima<std::vector<double>> serial {std::vector<double>(x), std::vector<double>(y), std::vector<double>(z)};
+    bivariate_akima<std::vector<double>> two {thread_executor(2), std::vector<double>(x), std::vector<double>(y), std::vector<double>(z)};
+    bivariate_akima<std::vector<double>> four {thread_executor(4), std::move(x), std::move(y), std::move(z)};
+
+    std::mt19937_64 gen(3);
+    std::uniform_real_distribution<double> dist(0, 1);
+    std::size_t bitwise = 0;
+    double worst = 0;
+    for (int q = 0; q < 20000; ++q)
+    {
+        const double qx = dist(gen);
+        const double qy = dist(gen);
+        const double a = two(qx, qy);
+        const double b = four(qx, qy);
+        const double c = serial(qx, qy);
+        bitwise += std::memcmp(&a, &b, sizeof(double)) == 0 ? 0 : 1;
+        if (!std::isnan(b) || !std::isnan(c))
+        {
+            worst = (std::max)(worst, std::abs(b - c));
+        }
+    }
+    BOOST_TEST_EQ(bitwise, 0u);
+    BOOST_TEST_LT(worst, 1e-12);
+}
+
+int main ()
+{
+    test_triangulation();
+    test_interpolator();
+    return boost::report_errors();
+}
@@ -0,0 +1,185 @@
+//  (C) Copyright Matt Borland 2022.
+//  Use, modification and distribution are subject to the
+//  Boost Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+#include <boost/core/lightweight_test.hpp>
+// GCC cannot see that the limbs of a rational are set before they are compared in its normalization
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+#include <boost/multiprecision/cpp_int.hpp>
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#include <boost/math/interpolators/detail/triangulation.hpp>
+
+using boost::multiprecision::cpp_rational;
+using boost::math::interpolators::compensated_summation;
+using boost::math::interpolators::naive_summation;
+using boost::math::interpolators::pairwise_summation;
+using boost::math::interpolators::polygonal_area;
+
+// The area of the polygon of the vertices in order
+template <class Summation>
+double vertex_area (const std::vector<double>& x, const std::vector<double>& y, const Summation& summation)
+{
+    return polygonal_area(x.cbegin(), x.cend(), y.cbegin(), y.cend(), summation);
+}
+
+// The area of the polygon in rational arithmetic, from the same shoelace formula, so exact
+double exact_area (const std::vector<double>& x, const std::vector<double>& y)
+{
+    cpp_rational sum = 0;
+    for (std::size_t i = 0, j = x.size() - 1; i < x.size(); j = i++)
+    {
+        sum += (cpp_rational(x[i]) - x[j]) * (cpp_rational(y[j]) + y[i]);
+    }
+    return static_cast<double>(-sum / 2);
+}
+
+// A sliver of unit length and width about 2e-6, a million units from the axis, so that the magnitudes of
+// the terms of the shoelace sum add to about 10^12 times its area: out along the bottom and back along
+// the top, counterclockwise
+void sliver (std::size_t n, std::vector<double>& x, std::vector<double>& y)
+{
+    std::mt19937_64 gen(37);
+    std::uniform_real_distribution<double> width(0.5e-6, 1.5e-6);
+    const double offset = 1e6;
+    x.clear();
+    y.clear();
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        x.push_back(static_cast<double>(i) / static_cast<double>(n - 1));
+        y.push_back(offset - width(gen));
+    }
+    for (std::size_t i = n; i-- > 0;)
+    {
+        x.push_back(static_cast<double>(i) / static_cast<double>(n - 1));
+        y.push_back(offset + width(gen));
+    }
+}
+
+// The compensated sum is as accurate as in twice the precision, and the pairwise sum loses less than the
+// naive one, which has the wrong magnitude
+void test_ill_conditioned ()
+{
+    std::vector<double> x, y;
+    sliver(20000, x, y);
+    const double exact = exact_area(x, y);
+    BOOST_TEST_GT(exact, 0);
+
+    const double naive = std::abs(vertex_area(x, y, naive_summation()) - exact) / exact;
+    const double pairwise = std::abs(vertex_area(x, y, pairwise_summation()) - exact) / exact;
+    const double compensated = std::abs(vertex_area(x, y, compensated_summation()) - exact) / exact;
+    BOOST_TEST_GT(naive, 1e-3);
+    BOOST_TEST_LT(pairwise, naive / 10);
+    BOOST_TEST_LT(compensated, 1e-12);
+
+    // The curve through the nodes in reverse is clockwise, with the opposite area
+    std::vector<std::size_t> nodes(x.size());
+    for (std::size_t i = 0; i < nodes.size(); ++i)
+    {
+        nodes[i] = nodes.size() - 1 - i;
+    }
+    BOOST_TEST_LT(polygonal_area(x, y, nodes, compensated_summation()), 0);
+    BOOST_TEST(std::abs(polygonal_area(x, y, nodes, compensated_summation()) + exact) <= 1e-12 * exact);
+}
+
+// On a well conditioned polygon the three agree to rounding
+void test_well_conditioned ()
+{
+    const double pi = 3.14159265358979323846;
+    const std::size_t n = 1000;
+    std::vector<double> x(n), y(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        x[i] = std::cos(2 * pi * static_cast<double>(i) / static_cast<double>(n));
+        y[i] = std::sin(2 * pi * static_cast<double>(i) / static_cast<double>(n));
+    }
+    const double exact = exact_area(x, y);
+    BOOST_TEST(std::abs(vertex_area(x, y, naive_summation()) - exact) <= 1e-14 * exact);
+    BOOST_TEST(std::abs(vertex_area(x, y, pairwise_summation()) - exact) <= 1e-14 * exact);
+    BOOST_TEST(std::abs(vertex_area(x, y, compensated_summation()) - exact) <= 1e-15 * exact);
+
+    std::vector<double> z(n - 1);
+    BOOST_TEST_THROWS(vertex_area(x, z, naive_summation()), std::domain_error);
+}
+
+// Each area of a batch is that of its curve alone, bit for bit, for every policy; curves of fewer than
+// three nodes, including empty ones, have no area
+template <class Summation>
+void check_batch (const Summation& summation)
+{
+    std::mt19937_64 gen(38);
+    std::uniform_real_distribution<double> dist(-1, 1);
+    std::vector<double> x(500), y(500);
+    for (std::size_t i = 0; i < x.size(); ++i)
+    {
+        x[i] = dist(gen);
+        y[i] = dist(gen);
+    }
+
+    std::vector<std::size_t> nodes;
+    std::vector<std::size_t> offsets {0};
+    for (const std::size_t length : {0, 5, 1, 2, 0, 3, 40, 2, 301, 0})
+    {
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            nodes.push_back(static_cast<std::size_t>(gen() % x.size()));
+        }
+        offsets.push_back(nodes.size());
+    }
+
+    std::vector<double> areas(offsets.size() - 1, -1);
+    BOOST_TEST(polygonal_area(x, y, nodes, offsets, areas.begin(), summation) == areas.end());
+    for (std::size_t k = 0; k + 1 < offsets.size(); ++k)
+    {
+        const std::vector<std::size_t> curve(nodes.begin() + static_cast<std::ptrdiff_t>(offsets[k]),
+                                             nodes.begin() + static_cast<std::ptrdiff_t>(offsets[k + 1]));
+        const double alone = polygonal_area(x, y, curve, summation);
+        BOOST_TEST_EQ(areas[k], alone);
+        if (curve.size() < 3)
+        {
+            BOOST_TEST_EQ(areas[k], 0.0);
+        }
+    }
+
+    // Through the pointer overload, which runs the kernels of the container overloads, and with no curves
+    std::vector<double> iterated;
+    polygonal_area(x.data(), x.data() + x.size(), y.data(), y.data() + y.size(), nodes.data(), nodes.data() + nodes.size(),
+                   offsets.data(), offsets.data() + offsets.size(), std::back_inserter(iterated), summation);
+    BOOST_TEST(iterated == areas);
+    const std::vector<std::size_t> no_offsets;
+    std::vector<double> none;
+    polygonal_area(x, y, nodes, no_offsets, std::back_inserter(none), summation);
+    BOOST_TEST(none.empty());
+
+    // Offsets that decrease or pass the last node are rejected
+    std::vector<std::size_t> decreasing {0, 5, 3};
+    BOOST_TEST_THROWS(polygonal_area(x, y, nodes, decreasing, areas.begin(), summation), std::domain_error);
+    std::vector<std::size_t> past {0, nodes.size() + 1};
+    BOOST_TEST_THROWS(polygonal_area(x, y, nodes, past, areas.begin(), summation), std::domain_error);
+}
+
+void test_batched ()
+{
+    check_batch(naive_summation());
+    check_batch(pairwise_summation());
+    check_batch(compensated_summation());
+}
+
+int main ()
+{
+    test_ill_conditioned();
+    test_well_conditioned();
+    test_batched();
+    return boost::report_errors();
+}
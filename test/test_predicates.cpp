@@ -0,0 +1,136 @@
+//  (C) Copyright Matt Borland 2022.
+//  Use, modification and distribution are subject to the
+//  Boost Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <boost/core/lightweight_test.hpp>
+// GCC cannot see that the limbs of a rational are set before they are compared in its normalization
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+#include <boost/multiprecision/cpp_int.hpp>
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#include <boost/math/interpolators/detail/statistics.hpp>
+#include <boost/math/interpolators/detail/triangulation.hpp>
+
+using boost::multiprecision::cpp_rational;
+using boost::math::interpolators::collect_statistics;
+using boost::math::interpolators::detail::exact_predicate_counters;
+using boost::math::interpolators::detail::robust_incircle;
+using boost::math::interpolators::detail::robust_orient2d;
+
+template <typename Real>
+int sign (const Real& r)
+{
+    return r > 0 ? 1 : r < 0 ? -1 : 0;
+}
+
+// The determinants in rational arithmetic, which holds every double exactly
+int rational_orient2d (double ax, double ay, double bx, double by, double cx, double cy)
+{
+    const cpp_rational d = (cpp_rational(bx) - ax) * (cpp_rational(cy) - ay) - (cpp_rational(by) - ay) * (cpp_rational(cx) - ax);
+    return sign(d);
+}
+
+int rational_incircle (double ax, double ay, double bx, double by, double cx, double cy, double dx, double dy)
+{
+    const cpp_rational adx = cpp_rational(ax) - dx;
+    const cpp_rational ady = cpp_rational(ay) - dy;
+    const cpp_rational bdx = cpp_rational(bx) - dx;
+    const cpp_rational bdy = cpp_rational(by) - dy;
+    const cpp_rational cdx = cpp_rational(cx) - dx;
+    const cpp_rational cdy = cpp_rational(cy) - dy;
+    const cpp_rational d = (adx * adx + ady * ady) * (bdx * cdy - cdx * bdy) + (bdx * bdx + bdy * bdy) * (cdx * ady - adx * cdy) +
+                           (cdx * cdx + cdy * cdy) * (adx * bdy - bdx * ady);
+    return sign(d);
+}
+
+// Shewchuk's test: points within a few ulps of the line through (12, 12) and (24, 24), where the naive
+// determinant has the wrong sign for a large fraction of them
+void test_near_collinear_orient2d ()
+{
+    const std::uint64_t before = exact_predicate_counters().orient2d;
+    int wrong = 0;
+    for (int i = 0; i < 64; ++i)
+    {
+        for (int j = 0; j < 64; ++j)
+        {
+            const double px = 0.5 + i * std::numeric_limits<double>::epsilon();
+            const double py = 0.5 + j * std::numeric_limits<double>::epsilon();
+            if (sign(robust_orient2d<double, collect_statistics>(px, py, 12.0, 12.0, 24.0, 24.0)) != rational_orient2d(px, py, 12.0, 12.0, 24.0, 24.0))
+            {
+                ++wrong;
+            }
+        }
+    }
+    BOOST_TEST_EQ(wrong, 0);
+    BOOST_TEST_GT(exact_predicate_counters().orient2d, before);
+}
+
+// Points within a few ulps of the circle through three others, far from the origin relative to the
+// radius so that the lifted coordinates cancel
+void test_near_cocircular_incircle ()
+{
+    const std::uint64_t before = exact_predicate_counters().incircle;
+    const double offset = 1024;
+    int wrong = 0;
+    for (int i = -16; i <= 16; ++i)
+    {
+        for (int j = -16; j <= 16; ++j)
+        {
+            const double dx = offset + i * 2 * std::numeric_limits<double>::epsilon() * offset;
+            const double dy = offset - 1 + j * 2 * std::numeric_limits<double>::epsilon() * offset;
+            const double s = robust_incircle<double, collect_statistics>(offset + 1, offset, offset, offset + 1, offset - 1, offset, dx, dy);
+            if (sign(s) != rational_incircle(offset + 1, offset, offset, offset + 1, offset - 1, offset, dx, dy))
+            {
+                ++wrong;
+            }
+        }
+    }
+    BOOST_TEST_EQ(wrong, 0);
+    BOOST_TEST_GT(exact_predicate_counters().incircle, before);
+}
+
+// Exactly degenerate configurations are zero, not a rounding of either sign
+void test_degenerate ()
+{
+    BOOST_TEST_EQ(robust_orient2d(0.1, 0.1, 0.3, 0.3, 0.7, 0.7), static_cast<double>(rational_orient2d(0.1, 0.1, 0.3, 0.3, 0.7, 0.7)));
+    BOOST_TEST_EQ(sign(robust_incircle(1.0, 0.0, 0.0, 1.0, -1.0, 0.0, 0.0, -1.0)), 0);
+    BOOST_TEST_EQ(sign(robust_incircle(1e6 + 3, 1e6 + 4, 1e6 - 4, 1e6 + 3, 1e6 - 3, 1e6 - 4, 1e6 + 5, 1e6)), 0);
+}
+
+// The default policy, no_statistics, evaluates the same exact determinants without counting them
+void test_uncounted ()
+{
+    const std::uint64_t orient2d = exact_predicate_counters().orient2d;
+    const std::uint64_t incircle = exact_predicate_counters().incircle;
+    const double o = robust_orient2d<double, collect_statistics>(0.1, 0.1, 0.3, 0.3, 0.7, 0.7);
+    const double i = robust_incircle<double, collect_statistics>(1.0, 0.0, 0.0, 1.0, -1.0, 0.0, 0.0, -1.0);
+    BOOST_TEST_EQ(exact_predicate_counters().orient2d, orient2d + 1);
+    BOOST_TEST_EQ(exact_predicate_counters().incircle, incircle + 1);
+
+    BOOST_TEST_EQ(robust_orient2d(0.1, 0.1, 0.3, 0.3, 0.7, 0.7), o);
+    BOOST_TEST_EQ(robust_incircle(1.0, 0.0, 0.0, 1.0, -1.0, 0.0, 0.0, -1.0), i);
+    BOOST_TEST_EQ(exact_predicate_counters().orient2d, orient2d + 1);
+    BOOST_TEST_EQ(exact_predicate_counters().incircle, incircle + 1);
+}
+
+int main ()
+{
+    // Float coordinates are tested in double
+    static_assert(std::is_same<boost::math::interpolators::detail::triangulation<float>::predicate_type, double>::value, "");
+    static_assert(std::is_same<boost::math::interpolators::detail::triangulation<long double>::predicate_type, long double>::value, "");
+
+    test_near_collinear_orient2d();
+    test_near_cocircular_incircle();
+    test_degenerate();
+    test_uncounted();
+    return boost::report_errors();
+}
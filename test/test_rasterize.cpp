@@ -0,0 +1,107 @@
+//  (C) Copyright Matt Borland 2022.
+//  Use, modification and distribution are subject to the
+//  Boost Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/math/interpolators/bivariate_akima.hpp>
+#include <boost/math/interpolators/detail/thread_executor.hpp>
+#include "triangulation_checks.hpp"
+
+using boost::math::interpolators::bivariate_akima;
+using boost::math::interpolators::grid_spec;
+using boost::math::interpolators::detail::thread_executor;
+
+using akima_type = bivariate_akima<std::vector<double>>;
+
+akima_type make_akima ()
+{
+    std::vector<double> x, y;
+    uniform_nodes(2000, 18, x, y);
+    std::vector<double> z(x.size());
+    for (std::size_t i = 0; i < x.size(); ++i)
+    {
+        z[i] = std::cos(6 * x[i] * y[i]) + y[i];
+    }
+    return akima_type {std::move(x), std::move(y), std::move(z)};
+}
+
+// Compares the grid written at out with the pointwise values: NaN exactly outside of the convex hull,
+// and inside of it the value of operator(), up to rounding where a point lies on an edge and the
+// triangles differ
+void check_grid (const akima_type& akima, const grid_spec<double>& grid, const std::vector<double>& out)
+{
+    std::size_t hull = 0;
+    std::size_t values = 0;
+    std::size_t inside = 0;
+    for (std::size_t j = 0; j < grid.rows; ++j)
+    {
+        for (std::size_t i = 0; i < grid.columns; ++i)
+        {
+            const double qx = grid.x0 + static_cast<double>(i) * grid.dx;
+            const double qy = grid.y0 + static_cast<double>(j) * grid.dy;
+            const double expected = akima(qx, qy);
+            const double value = out[static_cast<std::size_t>(static_cast<std::ptrdiff_t>(j) * grid.row_stride +
+                                                              static_cast<std::ptrdiff_t>(i) * grid.column_stride)];
+            if (std::isnan(expected) || std::isnan(value))
+            {
+                hull += std::isnan(expected) == std::isnan(value) ? 0 : 1;
+                continue;
+            }
+            ++inside;
+            values += std::abs(value - expected) <= 1e-13 ? 0 : 1;
+        }
+    }
+    BOOST_TEST_EQ(hull, 0u);
+    BOOST_TEST_EQ(values, 0u);
+    BOOST_TEST_GT(inside, grid.columns * grid.rows / 2);
+}
+
+// A grid over more than the convex hull, in row major order
+void test_row_major ()
+{
+    const akima_type akima = make_akima();
+    const grid_spec<double> grid {-0.1, -0.1, 1.2 / 300, 1.2 / 200, 301, 201, 301};
+    std::vector<double> out(grid.columns * grid.rows, 0.5);
+    akima.rasterize(grid, out.data());
+    check_grid(akima, grid, out);
+}
+
+// Rows running from north to south, columns strided as in a raster of two bands, and tiles on threads
+void test_strided ()
+{
+    const akima_type akima = make_akima();
+    const std::size_t columns = 257;
+    const std::size_t rows = 129;
+    grid_spec<double> grid {-0.05, 1.05, 1.1 / 256, -1.1 / 128, columns, rows, static_cast<std::ptrdiff_t>(2 * columns), 2};
+    const double marker = -12345;
+    std::vector<double> out(2 * columns * rows, marker);
+    akima.rasterize(thread_executor(4), grid, out.data());
+    check_grid(akima, grid, out);
+
+    std::size_t touched = 0;
+    for (std::size_t k = 1; k < out.size(); k += 2)
+    {
+        touched += out[k] == marker ? 0 : 1;
+    }
+    BOOST_TEST_EQ(touched, 0u);
+
+    std::vector<double> sequential(2 * columns * rows, marker);
+    akima.rasterize(grid, sequential.data());
+    std::size_t different = 0;
+    for (std::size_t k = 0; k < out.size(); ++k)
+    {
+        different += (out[k] == sequential[k] || (std::isnan(out[k]) && std::isnan(sequential[k]))) ? 0 : 1;
+    }
+    BOOST_TEST_EQ(different, 0u);
+}
+
+int main ()
+{
+    test_row_major();
+    test_strided();
+    return boost::report_errors();
+}
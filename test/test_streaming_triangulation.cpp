@@ -0,0 +1,204 @@
+//  (C) Copyright Matt Borland 2022.
+//  Use, modification and distribution are subject to the
+//  Boost Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/math/interpolators/detail/streaming_triangulation.hpp>
+#include <boost/math/interpolators/detail/triangulation.hpp>
+#include "triangulation_checks.hpp"
+
+using boost::math::interpolators::detail::streaming_triangulation;
+using boost::math::interpolators::detail::triangulation;
+
+using triangle = std::array<std::uint64_t, 3>;
+
+// The nodes sorted by abscissa, as the stream requires
+void sorted_nodes (std::size_t n, unsigned seed, std::vector<double>& x, std::vector<double>& y)
+{
+    std::vector<double> ux, uy;
+    uniform_nodes(n, seed, ux, uy);
+    std::vector<std::size_t> order(n);
+    std::iota(order.begin(), order.end(), std::size_t(0));
+    std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) { return ux[a] < ux[b]; });
+    x.resize(n);
+    y.resize(n);
+    for (std::size_t k = 0; k < n; ++k)
+    {
+        x[k] = ux[order[k]];
+        y[k] = uy[order[k]];
+    }
+}
+
+template <class Triangulation>
+std::vector<triangle> in_memory (const Triangulation& tri)
+{
+    std::vector<triangle> result;
+    for (const auto& t : triangle_set(tri))
+    {
+        result.push_back({{t[0], t[1], t[2]}});
+    }
+    return result;
+}
+
+// Streams the nodes in strips of the given width, with the curves given with the strips of their last
+// points, and returns the triangles emitted, rotated as by triangle_set and sorted, and the most nodes
+// held at once
+std::vector<triangle> stream (const std::vector<double>& x, const std::vector<double>& y, double width,
+                              const std::vector<std::vector<std::uint64_t>>& curves, std::size_t& held)
+{
+    std::vector<triangle> emitted;
+    auto sink = [&emitted](std::uint64_t a, std::uint64_t b, std::uint64_t c)
+    {
+        triangle t {{a, b, c}};
+        std::rotate(t.begin(), std::min_element(t.begin(), t.end()), t.end());
+        emitted.push_back(t);
+    };
+
+    streaming_triangulation<double> s(0, 1, 0, 1);
+    held = 0;
+    std::size_t k = 0;
+    for (double front = width; k < x.size(); front += width)
+    {
+        const std::size_t first = k;
+        std::vector<double> cx, cy;
+        while (k < x.size() && x[k] < front)
+        {
+            cx.push_back(x[k]);
+            cy.push_back(y[k]);
+            ++k;
+        }
+        std::vector<std::vector<std::uint64_t>> chunk_curves;
+        for (const auto& curve : curves)
+        {
+            const std::uint64_t last = *std::max_element(curve.begin(), curve.end());
+            if (last >= first && last < k)
+            {
+                chunk_curves.push_back(curve);
+            }
+        }
+        s.push(cx, cy, chunk_curves, front, sink);
+        held = (std::max)(held, s.active());
+    }
+    s.finish(sink);
+    BOOST_TEST_EQ(s.size(), x.size());
+    std::sort(emitted.begin(), emitted.end());
+    return emitted;
+}
+
+// Each Delaunay triangle of all of the points is emitted once, while the nodes held are those of a
+// strip along the front
+void test_delaunay ()
+{
+    std::vector<double> x, y;
+    sorted_nodes(20000, 34, x, y);
+    std::size_t held = 0;
+    const std::vector<triangle> emitted = stream(x, y, 0.02, {}, held);
+    const triangulation<double> tri(x, y);
+    BOOST_TEST(emitted == in_memory(tri));
+    BOOST_TEST(std::adjacent_find(emitted.begin(), emitted.end()) == emitted.end());
+    BOOST_TEST_LT(held, x.size() / 10);
+}
+
+// With a breakline and a hole inside of one strip, the triangles are those of the constrained
+// triangulation of all of the points
+void test_constrained ()
+{
+    std::vector<double> x, y;
+    uniform_nodes(6000, 35, x, y);
+    const double curve_points[8][2] = {{0.505, 0.3}, {0.545, 0.3}, {0.545, 0.7}, {0.505, 0.7},
+                                       {0.51, 0.4}, {0.51, 0.5}, {0.54, 0.5}, {0.54, 0.4}};
+    for (const auto& p : curve_points)
+    {
+        x.push_back(p[0]);
+        y.push_back(p[1]);
+    }
+    std::vector<std::size_t> order(x.size());
+    std::iota(order.begin(), order.end(), std::size_t(0));
+    std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) { return x[a] < x[b]; });
+    std::vector<double> sx(x.size()), sy(x.size());
+    std::vector<std::uint64_t> position(x.size());
+    for (std::size_t k = 0; k < order.size(); ++k)
+    {
+        sx[k] = x[order[k]];
+        sy[k] = y[order[k]];
+        position[order[k]] = k;
+    }
+    std::vector<std::vector<std::uint64_t>> curves(2);
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+        curves[0].push_back(position[6000 + i]);
+        curves[1].push_back(position[6004 + i]);
+    }
+
+    std::size_t held = 0;
+    const std::vector<triangle> emitted = stream(sx, sy, 0.05, curves, held);
+    triangulation<double> tri(sx, sy);
+    tri.add_constraints(curves);
+    BOOST_TEST(emitted == in_memory(tri));
+    BOOST_TEST(emitted != in_memory(triangulation<double>(sx, sy)));
+}
+
+// Points behind the front, and curves through points retired, not yet arrived or across triangles
+// emitted, are rejected
+void test_rejected ()
+{
+    std::vector<double> x, y;
+    sorted_nodes(3000, 36, x, y);
+    auto sink = [](std::uint64_t, std::uint64_t, std::uint64_t) {};
+
+    streaming_triangulation<double> behind(0, 1, 0, 1);
+    behind.push(std::vector<double>(x.begin(), x.begin() + 1500), std::vector<double>(y.begin(), y.begin() + 1500), x[1500], sink);
+    const std::vector<double> early {x[1499] / 2};
+    BOOST_TEST_THROWS(behind.push(early, early, 1.0, sink), std::domain_error);
+
+    streaming_triangulation<double> s(0, 1, 0, 1);
+    s.push(x, y, 0.9, sink);
+    BOOST_TEST_THROWS(s.add_constraints(std::vector<std::vector<std::uint64_t>> {{0, 1, 2}}), std::domain_error);
+    BOOST_TEST_THROWS(s.add_constraints(std::vector<std::vector<std::uint64_t>> {{2998, 2999, 3000}}), std::domain_error);
+
+    // The held nodes of least and greatest ordinate behind the front, and one ahead of it, span triangles
+    // already emitted
+    const auto& tri = s.get_triangulation();
+    std::uint32_t low = 0;
+    std::uint32_t high = 0;
+    std::uint32_t ahead = 0;
+    for (std::uint32_t v = 0; v < tri.size(); ++v)
+    {
+        if (tri.x(v) < 0.85)
+        {
+            low = (tri.x(low) >= 0.85 || tri.y(v) < tri.y(low)) ? v : low;
+            high = (tri.x(high) >= 0.85 || tri.y(v) > tri.y(high)) ? v : high;
+        }
+        if (tri.x(v) > tri.x(ahead))
+        {
+            ahead = v;
+        }
+    }
+    bool crossed = false;
+    try
+    {
+        s.add_constraints(std::vector<std::vector<std::uint64_t>> {{s.node_id(low), s.node_id(ahead), s.node_id(high)}});
+    }
+    catch (const std::domain_error& e)
+    {
+        crossed = std::string(e.what()).find("emitted") != std::string::npos;
+    }
+    BOOST_TEST(crossed);
+}
+
+int main ()
+{
+    test_delaunay();
+    test_constrained();
+    test_rejected();
+    return boost::report_errors();
+}
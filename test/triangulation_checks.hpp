@@ -0,0 +1,113 @@
+//  (C) Copyright Matt Borland 2022.
+//  Use, modification and distribution are subject to the
+//  Boost Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_MATH_INTERPOLATORS_TEST_TRIANGULATION_CHECKS_HPP
+#define BOOST_MATH_INTERPOLATORS_TEST_TRIANGULATION_CHECKS_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <random>
+#include <vector>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/math/interpolators/detail/triangulation.hpp>
+
+// n nodes uniform on the unit square, the same for a given seed everywhere
+inline void uniform_nodes (std::size_t n, unsigned seed, std::vector<double>& x, std::vector<double>& y)
+{
+    std::mt19937_64 gen(seed);
+    std::uniform_real_distribution<double> dist(0, 1);
+    x.resize(n);
+    y.resize(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        x[i] = dist(gen);
+        y[i] = dist(gen);
+    }
+}
+
+// The real triangles of a triangulation, each rotated to start at its least vertex and the list sorted,
+// so that two triangulations of the same nodes compare equal whatever their numbering of the triangles
+template <class Triangulation>
+std::vector<std::array<typename Triangulation::index_type, 3>> triangle_set (const Triangulation& tri)
+{
+    using index_type = typename Triangulation::index_type;
+
+    std::vector<std::array<index_type, 3>> result;
+    for (index_type t = 0; t < tri.triangle_count(); ++t)
+    {
+        if (tri.is_ghost(t))
+        {
+            continue;
+        }
+        std::array<index_type, 3> v {{tri.vertex(t, 0), tri.vertex(t, 1), tri.vertex(t, 2)}};
+        std::rotate(v.begin(), std::min_element(v.begin(), v.end()), v.end());
+        result.push_back(v);
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+// The adjacency is symmetric, the real triangles are counterclockwise and no node lies strictly inside
+// the circumcircle of a triangle across one of its edges
+template <class Triangulation>
+void check_delaunay (const Triangulation& tri)
+{
+    using boost::math::interpolators::detail::robust_incircle;
+    using boost::math::interpolators::detail::robust_orient2d;
+    using index_type = typename Triangulation::index_type;
+    using predicate_type = typename Triangulation::predicate_type;
+
+    std::size_t asymmetric = 0;
+    std::size_t clockwise = 0;
+    std::size_t illegal = 0;
+    for (index_type t = 0; t < tri.triangle_count(); ++t)
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            const index_type u = tri.neighbor(t, i);
+            int back = -1;
+            for (int j = 0; j < 3; ++j)
+            {
+                if (tri.neighbor(u, j) == t && tri.vertex(u, (j + 1) % 3) == tri.vertex(t, (i + 2) % 3))
+                {
+                    back = j;
+                }
+            }
+            if (back < 0)
+            {
+                ++asymmetric;
+                continue;
+            }
+            if (tri.is_ghost(t) || tri.is_ghost(u))
+            {
+                continue;
+            }
+            const index_type a = tri.vertex(t, 0);
+            const index_type b = tri.vertex(t, 1);
+            const index_type c = tri.vertex(t, 2);
+            const index_type q = tri.vertex(u, back);
+            if (robust_incircle<predicate_type>(tri.x(a), tri.y(a), tri.x(b), tri.y(b), tri.x(c), tri.y(c), tri.x(q), tri.y(q)) > 0)
+            {
+                ++illegal;
+            }
+        }
+        if (!tri.is_ghost(t))
+        {
+            const index_type a = tri.vertex(t, 0);
+            const index_type b = tri.vertex(t, 1);
+            const index_type c = tri.vertex(t, 2);
+            if (!(robust_orient2d<predicate_type>(tri.x(a), tri.y(a), tri.x(b), tri.y(b), tri.x(c), tri.y(c)) > 0))
+            {
+                ++clockwise;
+            }
+        }
+    }
+    BOOST_TEST_EQ(asymmetric, 0u);
+    BOOST_TEST_EQ(clockwise, 0u);
+    BOOST_TEST_EQ(illegal, 0u);
+}
+
+#endif // BOOST_MATH_INTERPOLATORS_TEST_TRIANGULATION_CHECKS_HPP